@@ -1,378 +1,525 @@
-#include "Game/App.hpp"
-#include "Game/Game.hpp"
-#include "Game/GameCommon.hpp"
-#include "Game/Model.hpp"
-#include "Game/UnitDefinition.hpp"
-#include "Engine/Renderer/Renderer.hpp"
-#include "Engine/Input/InputSystem.hpp"
-#include "Engine/Audio/AudioSystem.hpp"
-#include "Engine/Window/Window.hpp"
-#include "Engine/Core/Clock.hpp"
-#include "Engine/Core/Time.hpp"
-#include "Engine/Core/DevConsole.hpp"
-#include "Engine/Renderer/DebugRenderSystem.hpp"
-#include "Engine/Core/NetSystem.hpp"
-#include "Engine/Core/StringUtils.hpp"
-
-
-App* g_theApp = nullptr;
-
-Renderer*	 g_theRenderer = nullptr;
-InputSystem* g_theInput = nullptr;
-AudioSystem* g_theAudio = nullptr;
-Window*		 g_theWindow = nullptr;
-
-Game* g_theGame = nullptr;
-
-
-//public game flow functions
-void App::Startup(char* commandLineString)
-{
-	XmlDocument gameConfigXml;
-	char const* filePath = "Data/GameConfig.xml";
-	XmlError result = gameConfigXml.LoadFile(filePath);
-	GUARANTEE_OR_DIE(result == tinyxml2::XML_SUCCESS, Stringf("Failed to open game config file!"));
-	XmlElement* root = gameConfigXml.RootElement();
-	g_gameConfigBlackboard.PopulateFromXmlElementAttributes(*root);
-
-	Strings commandLineSplit = SplitStringOnDelimiter(commandLineString, ' ');
-	if (commandLineSplit.size() == 2)
-	{
-		Strings configArgs = SplitStringOnDelimiter(commandLineSplit[1], '=');
-		if (configArgs.size() == 2)
-		{
-			XmlDocument batchGameConfigXml;
-			std::string batchFilePath = configArgs[1];
-			XmlError batchResult = batchGameConfigXml.LoadFile(batchFilePath.c_str());
-			GUARANTEE_OR_DIE(batchResult == tinyxml2::XML_SUCCESS, Stringf("Failed to open game config file!"));
-			XmlElement* batchRoot = batchGameConfigXml.RootElement();
-			g_gameConfigBlackboard.PopulateFromXmlElementAttributes(*batchRoot);
-		}
-	}
-
-	EventSystemConfig eventSystemConfig;
-	g_theEventSystem = new EventSystem(eventSystemConfig);
-	
-	InputSystemConfig inputSystemConfig;
-	g_theInput = new InputSystem(inputSystemConfig);
-
-	WindowConfig windowConfig;
-	windowConfig.m_windowTitle = g_gameConfigBlackboard.GetValue("windowTile", "Vaporum");
-	windowConfig.m_clientAspect = g_gameConfigBlackboard.GetValue("windowAspect", 2.0f);
-	windowConfig.m_inputSystem = g_theInput;
-	windowConfig.m_isFullscreen = g_gameConfigBlackboard.GetValue("windowFullscreen", true);
-	windowConfig.m_windowPosition = g_gameConfigBlackboard.GetValue("windowPosition", IntVec2());
-	windowConfig.m_windowSize = g_gameConfigBlackboard.GetValue("windowSize", IntVec2());
-	g_theWindow = new Window(windowConfig);
-
-	RendererConfig rendererConfig;
-	rendererConfig.m_window = g_theWindow;
-	g_theRenderer = new Renderer(rendererConfig);
-
-	DevConsoleConfig devConsoleConfig;
-	devConsoleConfig.m_renderer = g_theRenderer;
-	devConsoleConfig.m_camera = &m_devConsoleCamera;
-	g_theDevConsole = new DevConsole(devConsoleConfig);
-	
-	AudioSystemConfig audioSystemConfig;
-	g_theAudio = new AudioSystem(audioSystemConfig);
-	
-	g_theEventSystem->Startup();
-	g_theDevConsole->Startup();
-	g_theInput->Startup();
-	g_theWindow->Startup();
-	g_theRenderer->Startup();
-	g_theAudio->Startup();
-
-	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MAJOR, "Controls: ");
-	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, " L:     Load Model");
-	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, " W/S:   Move Forward/Back");
-	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, " A/D:   Move Left/Right");
-	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, " Z/C:   Move Up/Down");
-	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, " Q/E:   Roll Left/Right");
-	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, " Mouse: Look Around");
-	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, " Shift: Sprint");
-	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, " O:		Reset Camera");
-	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, " ~:     Open Dev Console");
-	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, " ESC:   Exit Game");
-	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, " Space: Start Game");
-
-	//SubscribeEventCallbackFunction("LoadGameConfig", Event_LoadGameConfig);
-
-	//g_theDevConsole->Execute(commandLineString);
-
-	NetSystemConfig netSystemConfig;
-	std::string modeString = g_gameConfigBlackboard.GetValue("netMode", "none");
-	if (modeString == "Client")
-	{
-		netSystemConfig.m_mode = NetSystemMode::CLIENT;
-	}
-	else if (modeString == "Server")
-	{
-		netSystemConfig.m_mode = NetSystemMode::SERVER;
-	}
-	netSystemConfig.m_hostAddress = g_gameConfigBlackboard.GetValue("netHostAddress", "127.0.0.1:27015");
-	netSystemConfig.m_sendBufferSize = g_gameConfigBlackboard.GetValue("netSendBufferSize", 1024);
-	netSystemConfig.m_recvBufferSize = g_gameConfigBlackboard.GetValue("netRecvBufferSize", 1024);
-	g_theNetSystem = new NetSystem(netSystemConfig);
-	g_theNetSystem->Startup();
-
-	DebugRenderConfig debugRenderConfig;
-	debugRenderConfig.m_renderer = g_theRenderer;
-	DebugRenderSystemStartup(debugRenderConfig);
-
-	g_theGame = new Game();
-	g_theGame->Startup();
-
-	SubscribeEventCallbackFunction("quit", Event_Quit);
-	
-	SubscribeEventCallbackFunction("RemoteCommand", Event_RemoteCommand);
-	SubscribeEventCallbackFunction("BurstTest", Event_BurstTest);
-
-	m_devConsoleCamera.SetOrthoView(Vec2(0.f, 0.f), Vec2(SCREEN_CAMERA_SIZE_X, SCREEN_CAMERA_SIZE_Y));
-}
-
-
-void App::Run()
-{
-	while (!IsQuitting())
-	{
-		RunFrame();
-	}
-}
-
-
-void App::Shutdown()
-{
-	//delete all models in unit definitions (gotta do it here so they last until the very end
-	for (int defIndex = 0; defIndex < UnitDefinition::s_unitDefinitions.size(); defIndex++)
-	{
-		Model* model = UnitDefinition::s_unitDefinitions[defIndex].m_model;
-		delete model;
-	}
-	
-	g_theGame->Shutdown();
-	delete g_theGame;
-	g_theGame = nullptr;
-
-	DebugRenderSystemShutdown();
-
-	g_theNetSystem->Shutdown();
-	delete g_theNetSystem;
-	g_theNetSystem = nullptr;
-
-	g_theAudio->Shutdown();
-	delete g_theAudio;
-	g_theAudio = nullptr;
-
-	g_theRenderer->Shutdown();
-	delete g_theRenderer;
-	g_theRenderer = nullptr;
-
-	g_theWindow->Shutdown();
-	delete g_theWindow;
-	g_theWindow = nullptr;
-
-	g_theInput->Shutdown();
-	delete g_theInput;
-	g_theInput = nullptr;
-
-	g_theDevConsole->Shutdown();
-	delete g_theDevConsole;
-	g_theDevConsole = nullptr;
-
-	g_theEventSystem->Shutdown();
-	delete g_theEventSystem;
-	g_theEventSystem = nullptr;
-}
-
-
-void App::RunFrame()
-{
-	//tick the system clock
-	Clock::TickSystemClock();
-
-	//run through the four parts of the frame
-	BeginFrame();
-	Update();
-	Render();
-	EndFrame();
-}
-
-
-//
-//public app utilities
-//
-bool App::HandleQuitRequested()
-{
-	m_isQuitting = true;
-	return m_isQuitting;
-}
-
-
-//
-//static app utilities
-//
-bool App::Event_Quit(EventArgs& args)
-{
-	UNUSED(args);
-
-	if (g_theApp != nullptr)
-	{
-		g_theApp->HandleQuitRequested();
-	}
-
-	return true;
-}
-
-
-bool App::Event_LoadGameConfig(EventArgs& args)
-{
-	XmlDocument gameConfigXml;
-	std::string filePath = args.GetValue("File", "Data/GameConfig.xml");
-	XmlError result = gameConfigXml.LoadFile(filePath.c_str());
-	GUARANTEE_OR_DIE(result == tinyxml2::XML_SUCCESS, Stringf("Failed to open game config file!"));
-	XmlElement* root = gameConfigXml.RootElement();
-	g_gameConfigBlackboard.PopulateFromXmlElementAttributes(*root);
-
-	return true;
-}
-
-
-bool App::Event_RemoteCommand(EventArgs& args)
-{
-	std::string command = args.GetValue("Command", "");
-	if (!command.empty())
-	{
-		TrimString(command, '\"');
-		g_theNetSystem->m_sendQueue.emplace_back(command);
-	}
-	
-	return true;
-}
-
-
-bool App::Event_BurstTest(EventArgs& args)
-{
-	UNUSED(args);
-
-	for (int burstIndex = 1; burstIndex <= 20; burstIndex++)
-	{
-		std::string command = Stringf("Echo Message=%i", burstIndex);
-		g_theNetSystem->m_sendQueue.emplace_back(command);
-	}
-
-	return true;
-}
-
-
-//
-//private game flow functions
-//
-void App::BeginFrame()
-{
-	g_theEventSystem->BeginFrame();
-	g_theDevConsole->BeginFrame();
-	g_theInput->BeginFrame();
-	g_theWindow->BeginFrame();
-	g_theRenderer->BeginFrame();
-	g_theAudio->BeginFrame();
-	g_theNetSystem->BeginFrame();
-
-	DebugRenderBeginFrame();
-}
-
-
-void App::Update()
-{
-	//quit or leave attract mode if q is pressed
-	if (g_theInput->WasKeyJustPressed(KEYCODE_ESC))
-	{
-		if (g_theGame->m_gameState == GameState::SPLASH || g_theGame->m_gameState == GameState::START)
-		{
-			HandleQuitRequested();
-		}
-		else if (g_theGame->m_gameState == GameState::PAUSE)
-		{
-			EventArgs args;
-			Game::ReturnToMainMenu(args);
-		}
-		//handle ESC in gameplay state in Game code
-	}
-
-	//recreate game if f8 is pressed
-	if (g_theInput->WasKeyJustPressed(KEYCODE_F8))
-	{
-		RestartGame();
-	}
-
-	//set mouse state based on game
-	/*if (!g_theDevConsole->IsOpen() && Window::GetWindowContext()->HasFocus())
-	{
-		g_theInput->SetCursorMode(true, true);
-	}
-	else
-	{
-		g_theInput->SetCursorMode(false, false);
-	}*/
-
-	//update the game
-	g_theGame->Update();
-
-	//go back to the start if the game finishes
-	if (g_theGame->m_isFinished)
-	{
-		RestartGame();
-	}
-}
-
-
-void App::Render() const
-{	
-	g_theGame->Render();
-
-	//render dev console separately from and after rest of game
-	g_theRenderer->BeginCamera(m_devConsoleCamera);
-	g_theDevConsole->Render(AABB2(0.0f, 0.0f, SCREEN_CAMERA_SIZE_X * 0.9f, SCREEN_CAMERA_SIZE_Y * 0.9f));
-	g_theRenderer->EndCamera(m_devConsoleCamera);
-}
-
-
-void App::EndFrame()
-{
-	if (g_theGame->m_isReturningToMainMenu)
-	{
-		EventArgs args;
-		args.SetValue("Command", "OtherPlayerQuit");
-		FireEvent("RemoteCommand", args);
-		g_theApp->RestartGame();
-		g_theGame->ExitSplash();
-		g_theGame->EnterStartMenu();
-	}
-	
-	g_theEventSystem->EndFrame();
-	g_theDevConsole->EndFrame();
-	g_theInput->EndFrame();
-	g_theWindow->EndFrame();
-	g_theRenderer->EndFrame();
-	g_theAudio->EndFrame();
-	g_theNetSystem->EndFrame();
-
-	DebugRenderEndFrame();
-}
-
-
-//
-//private app utilities
-//
-void App::RestartGame()
-{
-	//delete old game
-	g_theGame->Shutdown();
-	delete g_theGame;
-	g_theGame = nullptr;
-
-	//initialize new game
-	g_theGame = new Game();
-	g_theGame->Startup();
-}
+#include "Game/App.hpp"
+#include "Game/Game.hpp"
+#include "Game/GameCommon.hpp"
+#include "Game/FrameArena.hpp"
+#include "Game/NetBenchmark.hpp"
+#include "Game/NetProtocol.hpp"
+#include "Game/Model.hpp"
+#include "Game/Map.hpp"
+#include "Game/MapDefinition.hpp"
+#include "Game/TileDefinition.hpp"
+#include "Game/UnitDefinition.hpp"
+#include "Game/SoftwareRenderer.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Input/InputSystem.hpp"
+#include "Engine/Audio/AudioSystem.hpp"
+#include "Engine/Window/Window.hpp"
+#include "Engine/Core/Clock.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Renderer/DebugRenderSystem.hpp"
+#include "Engine/Core/NetSystem.hpp"
+#include "Engine/Core/StringUtils.hpp"
+
+
+App* g_theApp = nullptr;
+
+Renderer*	 g_theRenderer = nullptr;
+InputSystem* g_theInput = nullptr;
+AudioSystem* g_theAudio = nullptr;
+Window*		 g_theWindow = nullptr;
+
+Game* g_theGame = nullptr;
+
+FrameArena* g_theFrameArena = nullptr;
+
+NetProtocol* g_theNetProtocol = nullptr;
+
+
+//public game flow functions
+void App::Startup(char* commandLineString)
+{
+	XmlDocument gameConfigXml;
+	char const* filePath = "Data/GameConfig.xml";
+	XmlError result = gameConfigXml.LoadFile(filePath);
+	GUARANTEE_OR_DIE(result == tinyxml2::XML_SUCCESS, Stringf("Failed to open game config file!"));
+	XmlElement* root = gameConfigXml.RootElement();
+	g_gameConfigBlackboard.PopulateFromXmlElementAttributes(*root);
+
+	Strings commandLineSplit = SplitStringOnDelimiter(commandLineString, ' ');
+	if (commandLineSplit.size() == 2)
+	{
+		Strings configArgs = SplitStringOnDelimiter(commandLineSplit[1], '=');
+		if (configArgs.size() == 2)
+		{
+			XmlDocument batchGameConfigXml;
+			std::string batchFilePath = configArgs[1];
+			XmlError batchResult = batchGameConfigXml.LoadFile(batchFilePath.c_str());
+			GUARANTEE_OR_DIE(batchResult == tinyxml2::XML_SUCCESS, Stringf("Failed to open game config file!"));
+			XmlElement* batchRoot = batchGameConfigXml.RootElement();
+			g_gameConfigBlackboard.PopulateFromXmlElementAttributes(*batchRoot);
+		}
+	}
+
+	EventSystemConfig eventSystemConfig;
+	g_theEventSystem = new EventSystem(eventSystemConfig);
+
+	//a headless run renders one thumbnail on the CPU and quits, without ever creating a window or a renderer
+	//the dev console only collects lines here, it's never started or drawn
+	m_isHeadless = g_gameConfigBlackboard.GetValue("headlessThumbnail", false);
+	if (m_isHeadless)
+	{
+		DevConsoleConfig devConsoleConfig;
+		g_theDevConsole = new DevConsole(devConsoleConfig);
+		g_theEventSystem->Startup();
+		return;
+	}
+	
+	InputSystemConfig inputSystemConfig;
+	g_theInput = new InputSystem(inputSystemConfig);
+
+	WindowConfig windowConfig;
+	windowConfig.m_windowTitle = g_gameConfigBlackboard.GetValue("windowTile", "Vaporum");
+	windowConfig.m_clientAspect = g_gameConfigBlackboard.GetValue("windowAspect", 2.0f);
+	windowConfig.m_inputSystem = g_theInput;
+	windowConfig.m_isFullscreen = g_gameConfigBlackboard.GetValue("windowFullscreen", true);
+	windowConfig.m_windowPosition = g_gameConfigBlackboard.GetValue("windowPosition", IntVec2());
+	windowConfig.m_windowSize = g_gameConfigBlackboard.GetValue("windowSize", IntVec2());
+	g_theWindow = new Window(windowConfig);
+
+	RendererConfig rendererConfig;
+	rendererConfig.m_window = g_theWindow;
+	g_theRenderer = new Renderer(rendererConfig);
+
+	DevConsoleConfig devConsoleConfig;
+	devConsoleConfig.m_renderer = g_theRenderer;
+	devConsoleConfig.m_camera = &m_devConsoleCamera;
+	g_theDevConsole = new DevConsole(devConsoleConfig);
+	
+	AudioSystemConfig audioSystemConfig;
+	g_theAudio = new AudioSystem(audioSystemConfig);
+	
+	g_theEventSystem->Startup();
+	g_theDevConsole->Startup();
+	g_theInput->Startup();
+	g_theWindow->Startup();
+	g_theRenderer->Startup();
+	g_theAudio->Startup();
+
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MAJOR, "Controls: ");
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, " L:     Load Model");
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, " W/S:   Move Forward/Back");
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, " A/D:   Move Left/Right");
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, " Z/C:   Move Up/Down");
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, " Q/E:   Roll Left/Right");
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, " Mouse: Look Around");
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, " Shift: Sprint");
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, " O:		Reset Camera");
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, " F1:    Toggle Debug Text");
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, " ~:     Open Dev Console");
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, " ESC:   Exit Game");
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, " Space: Start Game");
+
+	//SubscribeEventCallbackFunction("LoadGameConfig", Event_LoadGameConfig);
+
+	//g_theDevConsole->Execute(commandLineString);
+
+	//over UDP the game opens its own socket, so the engine's TCP connection stays off
+	std::string transportString = g_gameConfigBlackboard.GetValue("netTransport", "tcp");
+	NetTransport transport = transportString == "udp" ? NetTransport::UDP : NetTransport::TCP;
+
+	NetSystemConfig netSystemConfig;
+	std::string modeString = transport == NetTransport::UDP ? "none" : g_gameConfigBlackboard.GetValue("netMode", "none");
+	if (modeString == "Client")
+	{
+		netSystemConfig.m_mode = NetSystemMode::CLIENT;
+	}
+	else if (modeString == "Server")
+	{
+		netSystemConfig.m_mode = NetSystemMode::SERVER;
+	}
+	netSystemConfig.m_hostAddress = g_gameConfigBlackboard.GetValue("netHostAddress", "127.0.0.1:27015");
+	netSystemConfig.m_sendBufferSize = g_gameConfigBlackboard.GetValue("netSendBufferSize", 1024);
+	netSystemConfig.m_recvBufferSize = g_gameConfigBlackboard.GetValue("netRecvBufferSize", 1024);
+	g_theNetSystem = new NetSystem(netSystemConfig);
+	g_theNetSystem->Startup();
+
+	//binary commands by default, text kept around for debugging with a plain console on the other end
+	std::string protocolString = g_gameConfigBlackboard.GetValue("netProtocol", "binary");
+	g_theNetProtocol = new NetProtocol(protocolString == "text" ? NetProtocolMode::TEXT : NetProtocolMode::BINARY, transport);
+
+	DebugRenderConfig debugRenderConfig;
+	debugRenderConfig.m_renderer = g_theRenderer;
+	DebugRenderSystemStartup(debugRenderConfig);
+
+	g_theFrameArena = new FrameArena(FRAME_ARENA_SIZE_BYTES);
+
+	g_theGame = new Game();
+	g_theGame->Startup();
+
+	SubscribeEventCallbackFunction("quit", Event_Quit);
+	
+	SubscribeEventCallbackFunction("RemoteCommand", Event_RemoteCommand);
+	SubscribeEventCallbackFunction("BurstTest", Event_BurstTest);
+
+	m_devConsoleCamera.SetOrthoView(Vec2(0.f, 0.f), Vec2(SCREEN_CAMERA_SIZE_X, SCREEN_CAMERA_SIZE_Y));
+}
+
+
+void App::Run()
+{
+	if (m_isHeadless)
+	{
+		m_exitCode = RunHeadlessThumbnail();
+		return;
+	}
+
+	while (!IsQuitting())
+	{
+		RunFrame();
+	}
+}
+
+
+void App::Shutdown()
+{
+	//delete all models in unit definitions (gotta do it here so they last until the very end
+	for (int defIndex = 0; defIndex < UnitDefinition::s_unitDefinitions.size(); defIndex++)
+	{
+		Model* model = UnitDefinition::s_unitDefinitions[defIndex].m_model;
+		delete model;
+	}
+
+	if (m_isHeadless)
+	{
+		delete g_theDevConsole;
+		g_theDevConsole = nullptr;
+
+		g_theEventSystem->Shutdown();
+		delete g_theEventSystem;
+		g_theEventSystem = nullptr;
+		return;
+	}
+	
+	g_theGame->Shutdown();
+	delete g_theGame;
+	g_theGame = nullptr;
+
+	delete g_theFrameArena;
+	g_theFrameArena = nullptr;
+
+	DebugRenderSystemShutdown();
+
+	delete g_theNetProtocol;
+	g_theNetProtocol = nullptr;
+
+	g_theNetSystem->Shutdown();
+	delete g_theNetSystem;
+	g_theNetSystem = nullptr;
+
+	g_theAudio->Shutdown();
+	delete g_theAudio;
+	g_theAudio = nullptr;
+
+	g_theRenderer->Shutdown();
+	delete g_theRenderer;
+	g_theRenderer = nullptr;
+
+	g_theWindow->Shutdown();
+	delete g_theWindow;
+	g_theWindow = nullptr;
+
+	g_theInput->Shutdown();
+	delete g_theInput;
+	g_theInput = nullptr;
+
+	g_theDevConsole->Shutdown();
+	delete g_theDevConsole;
+	g_theDevConsole = nullptr;
+
+	g_theEventSystem->Shutdown();
+	delete g_theEventSystem;
+	g_theEventSystem = nullptr;
+}
+
+
+void App::RunFrame()
+{
+	//tick the system clock
+	Clock::TickSystemClock();
+
+	//run through the four parts of the frame
+	BeginFrame();
+	Update();
+	Render();
+	EndFrame();
+}
+
+
+//
+//public app utilities
+//
+bool App::HandleQuitRequested()
+{
+	m_isQuitting = true;
+	return m_isQuitting;
+}
+
+
+//
+//static app utilities
+//
+bool App::Event_Quit(EventArgs& args)
+{
+	UNUSED(args);
+
+	if (g_theApp != nullptr)
+	{
+		g_theApp->HandleQuitRequested();
+	}
+
+	return true;
+}
+
+
+bool App::Event_LoadGameConfig(EventArgs& args)
+{
+	XmlDocument gameConfigXml;
+	std::string filePath = args.GetValue("File", "Data/GameConfig.xml");
+	XmlError result = gameConfigXml.LoadFile(filePath.c_str());
+	GUARANTEE_OR_DIE(result == tinyxml2::XML_SUCCESS, Stringf("Failed to open game config file!"));
+	XmlElement* root = gameConfigXml.RootElement();
+	g_gameConfigBlackboard.PopulateFromXmlElementAttributes(*root);
+
+	return true;
+}
+
+
+bool App::Event_RemoteCommand(EventArgs& args)
+{
+	//raw commands only travel over the engine's TCP connection, which is left off when the game runs its own UDP socket
+	if (g_theNetProtocol->m_transport == NetTransport::UDP)
+	{
+		g_theDevConsole->AddLine(DevConsole::COLOR_ERROR, "RemoteCommand isn't available over the UDP transport!");
+		return true;
+	}
+
+	std::string command = args.GetValue("Command", "");
+	if (!command.empty())
+	{
+		TrimString(command, '\"');
+
+		//anything already batched this frame was issued first, so it goes out first
+		g_theNetProtocol->FlushSendBatch();
+		g_theNetSystem->m_sendQueue.emplace_back(command);
+	}
+	
+	return true;
+}
+
+
+bool App::Event_BurstTest(EventArgs& args)
+{
+	//e.g. BurstTest Count=5000 PayloadBytes=64 Rate=500, or Count=0 Rate=1000 Duration=10 to run for a fixed time
+	NetBenchmarkConfig config;
+	config.m_numMessages = args.GetValue("Count", config.m_numMessages);
+	config.m_payloadBytes = args.GetValue("PayloadBytes", config.m_payloadBytes);
+	config.m_messagesPerSecond = args.GetValue("Rate", config.m_messagesPerSecond);
+	config.m_durationSeconds = static_cast<double>(args.GetValue("Duration", static_cast<float>(config.m_durationSeconds)));
+	config.m_timeoutSeconds = static_cast<double>(args.GetValue("Timeout", static_cast<float>(config.m_timeoutSeconds)));
+	config.m_csvPath = args.GetValue("File", config.m_csvPath);
+
+	g_theNetProtocol->StartBenchmark(config);
+
+	return true;
+}
+
+
+//
+//private game flow functions
+//
+void App::BeginFrame()
+{
+	g_theEventSystem->BeginFrame();
+	g_theDevConsole->BeginFrame();
+	g_theInput->BeginFrame();
+	g_theWindow->BeginFrame();
+	g_theRenderer->BeginFrame();
+	g_theAudio->BeginFrame();
+	g_theNetSystem->BeginFrame();
+	g_theNetProtocol->BeginFrame();
+
+	DebugRenderBeginFrame();
+}
+
+
+void App::Update()
+{
+	//quit or leave attract mode if q is pressed
+	if (g_theInput->WasKeyJustPressed(KEYCODE_ESC))
+	{
+		if (g_theGame->m_gameState == GameState::SPLASH || g_theGame->m_gameState == GameState::START)
+		{
+			HandleQuitRequested();
+		}
+		else if (g_theGame->m_gameState == GameState::PAUSE)
+		{
+			EventArgs args;
+			Game::ReturnToMainMenu(args);
+		}
+		//handle ESC in gameplay state in Game code
+	}
+
+	//recreate game if f8 is pressed
+	if (g_theInput->WasKeyJustPressed(KEYCODE_F8))
+	{
+		RestartGame();
+	}
+
+	//set mouse state based on game
+	/*if (!g_theDevConsole->IsOpen() && Window::GetWindowContext()->HasFocus())
+	{
+		g_theInput->SetCursorMode(true, true);
+	}
+	else
+	{
+		g_theInput->SetCursorMode(false, false);
+	}*/
+
+	//update the game
+	g_theGame->Update();
+
+	//go back to the start if the game finishes
+	if (g_theGame->m_isFinished)
+	{
+		RestartGame();
+	}
+}
+
+
+void App::Render() const
+{	
+	g_theGame->Render();
+
+	//render dev console separately from and after rest of game
+	g_theRenderer->BeginCamera(m_devConsoleCamera);
+	g_theDevConsole->Render(AABB2(0.0f, 0.0f, SCREEN_CAMERA_SIZE_X * 0.9f, SCREEN_CAMERA_SIZE_Y * 0.9f));
+	g_theRenderer->EndCamera(m_devConsoleCamera);
+}
+
+
+void App::EndFrame()
+{
+	if (g_theGame->m_isReturningToMainMenu)
+	{
+		g_theNetProtocol->SendCommand(NetOpcode::OTHER_PLAYER_QUIT);
+		g_theApp->RestartGame();
+		g_theGame->ExitSplash();
+		g_theGame->EnterStartMenu();
+	}
+	
+	g_theEventSystem->EndFrame();
+	g_theDevConsole->EndFrame();
+	g_theInput->EndFrame();
+	g_theWindow->EndFrame();
+	g_theRenderer->EndFrame();
+	g_theAudio->EndFrame();
+	g_theNetProtocol->EndFrame();
+	g_theNetSystem->EndFrame();
+
+	DebugRenderEndFrame();
+
+	//everything allocated from the frame arena is dead by now
+	g_theFrameArena->Reset();
+}
+
+
+//
+//private app utilities
+//
+void App::RestartGame()
+{
+	//delete old game
+	g_theGame->Shutdown();
+	delete g_theGame;
+	g_theGame = nullptr;
+
+	//initialize new game
+	g_theGame = new Game();
+	g_theGame->Startup();
+}
+
+
+//
+//headless functions
+//
+int App::RunHeadlessThumbnail()
+{
+	//thumbnails are rendered top down with an orthographic camera, so the same map always produces the same image to compare against
+	MapDefinition::InitializeMapDefs();
+	TileDefinition::InitializeTileDefs();
+	UnitDefinition::InitializeUnitDefs();
+
+	std::string mapName = g_gameConfigBlackboard.GetValue("defaultMap", "Grid12x12");
+	MapDefinition const* definition = MapDefinition::GetMapDefinition(mapName);
+	if (definition == nullptr)
+	{
+		g_theDevConsole->AddLine(DevConsole::COLOR_ERROR, Stringf("Could not find map %s for headless thumbnail!", mapName.c_str()));
+		return 1;
+	}
+
+	IntVec2 dimensions = g_gameConfigBlackboard.GetValue("thumbnailSize", IntVec2(320, 160));
+	std::string filePath = g_gameConfigBlackboard.GetValue("thumbnailPath", "Data/Thumbnail.tga");
+	std::string goldenPath = g_gameConfigBlackboard.GetValue("thumbnailGolden", "");
+	int numThreads = g_gameConfigBlackboard.GetValue("thumbnailThreads", 0);
+	int channelTolerance = g_gameConfigBlackboard.GetValue("thumbnailTolerance", 2);
+
+	Map* map = new Map(definition);
+
+	//widen whichever side of the map bounds is short, so the map isn't stretched to the image's aspect
+	Vec2 boundsMin = Vec2(definition->m_boundsMin.x, definition->m_boundsMin.y);
+	Vec2 boundsMax = Vec2(definition->m_boundsMax.x, definition->m_boundsMax.y);
+	Vec2 boundsCenter = (boundsMin + boundsMax) * 0.5f;
+	Vec2 halfSize = (boundsMax - boundsMin) * 0.5f;
+	float imageAspect = static_cast<float>(dimensions.x) / static_cast<float>(dimensions.y);
+	if (halfSize.x < halfSize.y * imageAspect)
+	{
+		halfSize.x = halfSize.y * imageAspect;
+	}
+	else
+	{
+		halfSize.y = halfSize.x / imageAspect;
+	}
+
+	SoftwareTexture groundTexture;
+	bool hasGroundTexture = groundTexture.LoadFromTGAFile("Data/Images/MoonSurface.tga");
+
+	SoftwareRenderer renderer = SoftwareRenderer(dimensions, numThreads);
+	//view from the top of the camera bounds, which is above every tile and unit
+	renderer.BeginOrthoFrame(boundsCenter - halfSize, boundsCenter + halfSize, definition->m_boundsMax.z, Rgba8(50, 50, 50));
+	renderer.SetLightConstants(Vec3(0.5f, 0.5f, -1.0f), 0.9f, 0.2f);	//the game's default lighting
+	map->RenderSoftware(renderer, hasGroundTexture ? &groundTexture : nullptr);
+	renderer.EndFrame();
+
+	delete map;
+
+	if (!renderer.SaveToTGAFile(filePath))
+	{
+		return 1;
+	}
+
+	if (goldenPath.empty())
+	{
+		return 0;
+	}
+
+	//0 if the thumbnail matches the golden image, 1 if either image couldn't be read, 2 if they differ
+	int numMismatchedPixels = renderer.CompareToTGAFile(goldenPath, channelTolerance);
+	if (numMismatchedPixels < 0)
+	{
+		g_theDevConsole->AddLine(DevConsole::COLOR_ERROR, Stringf("Could not compare headless thumbnail against %s!", goldenPath.c_str()));
+		return 1;
+	}
+
+	return numMismatchedPixels == 0 ? 0 : 2;
+}
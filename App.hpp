@@ -1,39 +1,45 @@
-#pragma once
-#include "Engine/Math/Vec2.hpp"
-#include "Engine/Core/EngineCommon.hpp"
-#include "Engine/Renderer/Camera.hpp"
-
-class App
-{
-//public member functions
-public:
-	//game flow functions
-	void Startup(char* commandLineString);
-	void Run();
-	void Shutdown();
-	void RunFrame();
-
-	//app utilities
-	bool IsQuitting() const { return m_isQuitting; }
-	bool HandleQuitRequested();
-	void RestartGame();
-
-	//static app utilites
-	static bool Event_Quit(EventArgs& args);
-	static bool Event_LoadGameConfig(EventArgs& args);
-	static bool Event_RemoteCommand(EventArgs& args);
-	static bool Event_BurstTest(EventArgs& args);
-
-//private member variables
-private:
-	//game flow functions
-	void BeginFrame();
-	void Update();
-	void Render() const;
-	void EndFrame();
-
-//private member variables
-private:
-	bool m_isQuitting = false;
-	Camera m_devConsoleCamera;
-};
+#pragma once
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Renderer/Camera.hpp"
+
+class App
+{
+//public member functions
+public:
+	//game flow functions
+	void Startup(char* commandLineString);
+	void Run();
+	void Shutdown();
+	void RunFrame();
+
+	//app utilities
+	bool IsQuitting() const { return m_isQuitting; }
+	int  GetExitCode() const { return m_exitCode; }
+	bool HandleQuitRequested();
+	void RestartGame();
+
+	//static app utilites
+	static bool Event_Quit(EventArgs& args);
+	static bool Event_LoadGameConfig(EventArgs& args);
+	static bool Event_RemoteCommand(EventArgs& args);
+	static bool Event_BurstTest(EventArgs& args);
+
+//private member variables
+private:
+	//game flow functions
+	void BeginFrame();
+	void Update();
+	void Render() const;
+	void EndFrame();
+
+	//headless functions
+	int RunHeadlessThumbnail();
+
+//private member variables
+private:
+	bool m_isQuitting = false;
+	bool m_isHeadless = false;
+	int	 m_exitCode = 0;
+	Camera m_devConsoleCamera;
+};
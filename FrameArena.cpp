@@ -0,0 +1,86 @@
+#include "Game/FrameArena.hpp"
+#include <new>
+
+
+//
+//constructor and destructor
+//
+FrameArena::FrameArena(size_t capacityBytes)
+	: m_capacityBytes(capacityBytes)
+{
+	m_memory = new unsigned char[capacityBytes];
+}
+
+
+FrameArena::~FrameArena()
+{
+	delete[] m_memory;
+	m_memory = nullptr;
+}
+
+
+//
+//arena functions
+//
+void* FrameArena::Allocate(size_t numBytes, size_t alignment)
+{
+	size_t alignedStart = (m_usedBytes + alignment - 1) & ~(alignment - 1);
+
+	//fall back to the heap if the arena is full so the frame still renders, but count it so it shows up in the debug text
+	if (alignedStart + numBytes > m_capacityBytes)
+	{
+		m_numOverflowAllocations++;
+		return ::operator new(numBytes, std::align_val_t(alignment));
+	}
+
+	m_usedBytes = alignedStart + numBytes;
+	if (m_usedBytes > m_highWaterBytes)
+	{
+		m_highWaterBytes = m_usedBytes;
+	}
+
+	return m_memory + alignedStart;
+}
+
+
+void FrameArena::Deallocate(void* memory, size_t alignment)
+{
+	//arena memory is only released all at once in Reset
+	if (!Owns(memory))
+	{
+		::operator delete(memory, std::align_val_t(alignment));
+	}
+}
+
+
+bool FrameArena::Owns(void const* memory) const
+{
+	unsigned char const* bytes = static_cast<unsigned char const*>(memory);
+	return bytes >= m_memory && bytes < m_memory + m_capacityBytes;
+}
+
+
+void FrameArena::Reset()
+{
+	m_usedBytes = 0;
+}
+
+
+//
+//vertex helpers for frame containers
+//
+void AddVertsForAABB2(FrameVector<Vertex_PCU>& verts, AABB2 const& bounds, Rgba8 const& color, Vec2 const& uvMins, Vec2 const& uvMaxs)
+{
+	Vec3 bottomLeft = Vec3(bounds.m_mins.x, bounds.m_mins.y, 0.0f);
+	Vec3 bottomRight = Vec3(bounds.m_maxs.x, bounds.m_mins.y, 0.0f);
+	Vec3 topLeft = Vec3(bounds.m_mins.x, bounds.m_maxs.y, 0.0f);
+	Vec3 topRight = Vec3(bounds.m_maxs.x, bounds.m_maxs.y, 0.0f);
+
+	verts.emplace_back(Vertex_PCU(bottomLeft, color, uvMins));
+	verts.emplace_back(Vertex_PCU(bottomRight, color, Vec2(uvMaxs.x, uvMins.y)));
+	verts.emplace_back(Vertex_PCU(topRight, color, uvMaxs));
+
+	verts.emplace_back(Vertex_PCU(bottomLeft, color, uvMins));
+	verts.emplace_back(Vertex_PCU(topRight, color, uvMaxs));
+	verts.emplace_back(Vertex_PCU(topLeft, color, Vec2(uvMins.x, uvMaxs.y)));
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include "Game/GameCommon.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Math/AABB2.hpp"
+
+
+class FrameArena
+{
+//public member functions
+public:
+	//constructor and destructor
+	explicit FrameArena(size_t capacityBytes);
+	FrameArena(FrameArena const& copy) = delete;
+	~FrameArena();
+
+	//arena functions
+	void* Allocate(size_t numBytes, size_t alignment);
+	void  Deallocate(void* memory, size_t alignment);
+	bool  Owns(void const* memory) const;
+	void  Reset();
+
+//public member variables
+public:
+	unsigned char* m_memory = nullptr;
+	size_t		   m_capacityBytes = 0;
+	size_t		   m_usedBytes = 0;
+	size_t		   m_highWaterBytes = 0;
+	int			   m_numOverflowAllocations = 0;
+};
+
+
+//allocator for standard containers that only live until the end of the frame
+template <typename T>
+class FrameAllocator
+{
+public:
+	using value_type = T;
+
+	FrameAllocator() = default;
+	template <typename U> FrameAllocator(FrameAllocator<U> const&) {}
+
+	T* allocate(size_t count)
+	{
+		return static_cast<T*>(g_theFrameArena->Allocate(count * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T* memory, size_t count)
+	{
+		UNUSED(count);
+		g_theFrameArena->Deallocate(memory, alignof(T));
+	}
+
+	template <typename U> bool operator==(FrameAllocator<U> const&) const { return true; }
+	template <typename U> bool operator!=(FrameAllocator<U> const&) const { return false; }
+};
+
+
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+
+//vertex helpers for frame containers
+void AddVertsForAABB2(FrameVector<Vertex_PCU>& verts, AABB2 const& bounds, Rgba8 const& color = Rgba8(), Vec2 const& uvMins = Vec2(0.0f, 0.0f), Vec2 const& uvMaxs = Vec2(1.0f, 1.0f));
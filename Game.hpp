@@ -1,121 +1,186 @@
-#pragma once
-#include "Game/GameCommon.hpp"
-#include "Engine/Renderer/Camera.hpp"
-#include "Engine/Audio/AudioSystem.hpp"
-#include "Engine/Core/Clock.hpp"
-#include "Engine/Core/Vertex_PCUTBN.hpp"
-#include "Engine/Input/Button.hpp"
-
-
-//forward declarations
-class GameCamera;
-class Map;
-class MapDefinition;
-class Shader;
-class Texture;
-class BitmapFont;
-
-
-enum class GameState
-{
-	GAMEPLAY,
-	SPLASH,
-	START,
-	PAUSE,
-	WAITING
-};
-
-
-class Game 
-{
-//public member functions
-public:
-	//game flow functions
-	void Startup();
-	void Update();
-	void Render() const;
-	void Shutdown();
-
-	void UpdateGameplay();
-	void RenderGameplay() const;
-	void UpdateSplash();
-	void RenderSplash() const;
-	void UpdateStartMenu();
-	void RenderStartMenu() const;
-	void UpdatePauseMenu();
-	void RenderPauseMenu() const;
-	void UpdateWaiting();
-	void RenderWaiting() const;
-
-	void EnterGameplay();
-	void ExitGameplay();
-	void EnterSplash();
-	void ExitSplash();
-	void EnterStartMenu();
-	void ExitStartMenu();
-	void EnterPauseMenu();
-	void ExitPauseMenu();
-	void EnterWaiting();
-	void ExitWaiting();
-
-	//gameplay functions
-	void InitializeMap(MapDefinition const* definition);
-	void UpdateCommandBar();
-	void RenderCommandBar() const;
-
-	//command functions
-	static bool LoadMapCommand(EventArgs& args);
-	static bool StartNewGame(EventArgs& args);
-	static bool ResumeGame(EventArgs& args);
-	static bool ReturnToMainMenu(EventArgs& args);
-	static bool RemotePlayerReady(EventArgs& args);
-	static bool OtherPlayerQuit(EventArgs& args);
-
-	//data loading functions
-	void LoadDefinitions();
-	void LoadAssets();
-
-//public member variables
-public:
-	//game state variables
-	bool	  m_isFinished = false;
-	bool	  m_isReturningToMainMenu = false;
-	GameState m_gameState = GameState::SPLASH;
-	bool	  m_remotePlayerReady = false;
-	bool	  m_remotePlayerQuit = false;
-	int		  m_playerID = 0;
-
-	//game clock
-	Clock m_gameClock = Clock();
-
-	//game objects
-	GameCamera*	m_gameCamera = nullptr;
-	Map*		m_currentMap = nullptr;
-
-	//assets
-	Texture*	m_logo = nullptr;
-	Texture*	m_ground = nullptr;
-	BitmapFont* m_font = nullptr;
-
-	//UI buttons
-	Button* m_localGameButton = nullptr;
-	Button* m_quitButton = nullptr;
-	Button* m_resumeGameButton = nullptr;
-	Button* m_mainMenuButton = nullptr;
-	int m_currentMainMenuButton = 0;
-	int m_numMainMenuButtons = 2;
-	int m_currentPauseMenuButton = 0;
-	int m_numPauseMenuButtons = 2;
-	Button* m_leftButton = nullptr;
-	Button* m_rightButton = nullptr;
-	Button* m_escButton = nullptr;
-	Button* m_enterButton = nullptr;
-
-	//camera variables
-	Camera m_screenCamera;
-
-	//lighting variables
-	Vec3  m_sunDirection = Vec3(0.5f, 0.5f, -1.0f);
-	float m_sunIntensity = 0.9f;
-	float m_ambientIntensity = 0.2f;
-};
+#pragma once
+#include "Game/GameCommon.hpp"
+#include "Engine/Renderer/Camera.hpp"
+#include "Engine/Audio/AudioSystem.hpp"
+#include "Engine/Core/Clock.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Core/Vertex_PCUTBN.hpp"
+#include "Engine/Input/Button.hpp"
+
+
+//forward declarations
+class GameCamera;
+class Map;
+class RenderQueue;
+class MapDefinition;
+class Shader;
+class Texture;
+class BitmapFont;
+class UnitDefinition;
+struct SoftwareTexture;
+enum class PlayerState;
+
+
+enum class GameState
+{
+	GAMEPLAY,
+	SPLASH,
+	START,
+	PAUSE,
+	WAITING
+};
+
+
+enum class PromptType
+{
+	NONE,
+	TURN_START,
+	END_TURN,
+	PLAYER_1_WINS,
+	PLAYER_2_WINS,
+	REMOTE_PLAYER_QUIT
+};
+
+
+//everything the modal prompts display, so they are only laid out again when it changes
+struct PromptLayoutKey
+{
+	PromptType m_statePrompt = PromptType::NONE;
+	PromptType m_resultPrompt = PromptType::NONE;
+	int		   m_turnPlayer = 0;
+	int		   m_localPlayer = 0;
+
+	bool operator==(PromptLayoutKey const& other) const;
+	bool operator!=(PromptLayoutKey const& other) const;
+};
+
+
+//everything the command bar displays, so it is only laid out again when it changes
+struct CommandBarLayoutKey
+{
+	PlayerState			  m_playerState = PlayerState();
+	UnitDefinition const* m_hoveredUnitDef = nullptr;
+	int					  m_hoveredUnitHealth = 0;
+
+	bool operator==(CommandBarLayoutKey const& other) const;
+	bool operator!=(CommandBarLayoutKey const& other) const;
+};
+
+
+class Game 
+{
+//public member functions
+public:
+	//game flow functions
+	void Startup();
+	void Update();
+	void Render() const;
+	void Shutdown();
+
+	void UpdateGameplay();
+	void RenderGameplay() const;
+	void UpdateSplash();
+	void RenderSplash() const;
+	void UpdateStartMenu();
+	void RenderStartMenu() const;
+	void UpdatePauseMenu();
+	void RenderPauseMenu() const;
+	void UpdateWaiting();
+	void RenderWaiting() const;
+
+	void EnterGameplay();
+	void ExitGameplay();
+	void EnterSplash();
+	void ExitSplash();
+	void EnterStartMenu();
+	void ExitStartMenu();
+	void EnterPauseMenu();
+	void ExitPauseMenu();
+	void EnterWaiting();
+	void ExitWaiting();
+
+	//gameplay functions
+	void InitializeMap(MapDefinition const* definition);
+	void UpdateCommandBar();
+	void RenderCommandBar() const;
+	void RebuildCommandBarVerts(CommandBarLayoutKey const& key) const;
+	void RenderPrompts() const;
+	void RebuildPromptVerts(PromptLayoutKey const& key) const;
+	void AddVertsForPromptText(std::string const& text, float centerY, float cellHeight) const;
+
+	//command functions
+	static bool LoadMapCommand(EventArgs& args);
+	static bool StartNewGame(EventArgs& args);
+	static bool ResumeGame(EventArgs& args);
+	static bool ReturnToMainMenu(EventArgs& args);
+	static bool RemotePlayerReady(EventArgs& args);
+	static bool OtherPlayerQuit(EventArgs& args);
+	static bool SaveThumbnailCommand(EventArgs& args);
+
+	//data loading functions
+	void LoadDefinitions();
+	void LoadAssets();
+
+//public member variables
+public:
+	//game state variables
+	bool	  m_isFinished = false;
+	bool	  m_isReturningToMainMenu = false;
+	GameState m_gameState = GameState::SPLASH;
+	bool	  m_remotePlayerReady = false;
+	bool	  m_remotePlayerQuit = false;
+	int		  m_playerID = 0;
+
+	//game clock
+	Clock m_gameClock = Clock();
+
+	//game objects
+	GameCamera*	m_gameCamera = nullptr;
+	Map*		m_currentMap = nullptr;
+
+	//rendering
+	RenderQueue* m_renderQueue = nullptr;
+
+	//per-frame debug text, off by default so nothing formats strings every frame unless asked to
+	bool m_isDebugTextVisible = false;
+
+	//assets
+	Texture*	m_logo = nullptr;
+	Texture*	m_ground = nullptr;
+	BitmapFont* m_font = nullptr;
+
+	//CPU copies of assets for the software renderer, null if there's no TGA version
+	SoftwareTexture* m_softwareGround = nullptr;
+
+	//UI buttons
+	Button* m_localGameButton = nullptr;
+	Button* m_quitButton = nullptr;
+	Button* m_resumeGameButton = nullptr;
+	Button* m_mainMenuButton = nullptr;
+	int m_currentMainMenuButton = 0;
+	int m_numMainMenuButtons = 2;
+	int m_currentPauseMenuButton = 0;
+	int m_numPauseMenuButtons = 2;
+	Button* m_leftButton = nullptr;
+	Button* m_rightButton = nullptr;
+	Button* m_escButton = nullptr;
+	Button* m_enterButton = nullptr;
+
+	//camera variables
+	Camera m_screenCamera;
+
+	//retained UI verts, rebuilt only when their layout key changes
+	mutable CommandBarLayoutKey		m_commandBarLayoutKey;
+	mutable bool					m_isCommandBarLayoutValid = false;
+	mutable std::vector<Vertex_PCU> m_commandBarBoxVerts;
+	mutable std::vector<Vertex_PCU> m_commandBarTextVerts;
+	mutable PromptLayoutKey			m_promptLayoutKey;
+	mutable bool					m_isPromptLayoutValid = false;
+	mutable std::vector<Vertex_PCU> m_promptBoxVerts;
+	mutable std::vector<Vertex_PCU> m_promptTextVerts;
+
+	//lighting variables
+	Vec3  m_sunDirection = Vec3(0.5f, 0.5f, -1.0f);
+	float m_sunIntensity = 0.9f;
+	float m_ambientIntensity = 0.2f;
+};
@@ -1,129 +1,215 @@
-#include "Game/GameCamera.hpp"
-#include "Game/Game.hpp"
-#include "Game/Map.hpp"
-#include "Engine/Core/EngineCommon.hpp"
-#include "Engine/Core/Clock.hpp"
-#include "Engine/Input/InputSystem.hpp"
-#include "Engine/Math/IntVec2.hpp"
-#include "Engine/Math/MathUtils.hpp"
-#include "Engine/Renderer/DebugRenderSystem.hpp"
-
-
-//
-//constructor
-//
-GameCamera::GameCamera(Game* owner)
-	:Entity(owner)
-{
-}
-
-
-//
-//public game flow functions
-//
-void GameCamera::Update()
-{
-	float systemDeltaSeconds = Clock::GetSystemClock().GetDeltaSeconds();
-
-	m_isSpeedUp = false;
-
-	Vec3 movementIntentions = Vec3();
-
-	if (g_theInput->IsKeyDown('W'))
-	{
-		movementIntentions.y += 1.0f;
-	}
-	if (g_theInput->IsKeyDown('S'))
-	{
-		movementIntentions.y -= 1.0f;
-	}
-	if (g_theInput->IsKeyDown('A'))
-	{
-		movementIntentions.x -= 1.0f;
-	}
-	if (g_theInput->IsKeyDown('D'))
-	{
-		movementIntentions.x += 1.0f;
-	}
-	if (g_theInput->IsKeyDown('Q'))
-	{
-		movementIntentions.z += 1.0f;
-	}
-	if (g_theInput->IsKeyDown('E'))
-	{
-		movementIntentions.z -= 1.0f;
-	}
-
-	if (g_theInput->IsKeyDown(KEYCODE_SHIFT))
-	{
-		m_isSpeedUp = true;
-	}
-
-	m_velocity = Vec3(movementIntentions.x, movementIntentions.y, 0.0f) * m_panSpeed;
-	m_velocity += Vec3(0.0f, 0.0f, movementIntentions.z) * m_elevateSpeed;
-
-	UpdateFromController();
-
-	if (m_isSpeedUp)
-	{
-		systemDeltaSeconds *= 10.0f;
-	}
-
-	m_position += m_velocity * systemDeltaSeconds;
-
-	//clamp camera according to min height, then world z, then projected world xy
-	m_position.z = GetClamped(m_position.z, m_minHeight, FLT_MAX);
-	MapDefinition const* mapDef = g_theGame->m_currentMap->m_definition;
-	m_position.z = GetClamped(m_position.z, mapDef->m_boundsMin.z, mapDef->m_boundsMax.z);
-	Vec3 raycastVector = GetModelMatrix().GetIBasis3D() * FLT_MAX;
-	float t = (-m_position.z) / raycastVector.z;
-	Vec3 posAtT = m_position + (raycastVector * t);
-	
-	float clampedX = GetClamped(posAtT.x, g_theGame->m_currentMap->m_definition->m_boundsMin.x, g_theGame->m_currentMap->m_definition->m_boundsMax.x);
-	float clampedY = GetClamped(posAtT.y, g_theGame->m_currentMap->m_definition->m_boundsMin.y, g_theGame->m_currentMap->m_definition->m_boundsMax.y);
-	float offsetX = posAtT.x - clampedX;
-	m_position.x -= offsetX;
-	float offsetY = posAtT.y - clampedY;
-	m_position.y -= offsetY;
-
-	m_camera.SetTransform(m_position, m_orientation);
-}
-
-
-void GameCamera::UpdateFromController()
-{
-	XboxController const& controller = g_theInput->GetController(0);
-	AnalogJoystick const& leftStick = controller.GetLeftStick();
-	float leftStickMagnitude = leftStick.GetMagnitude();
-
-	Vec3 movementIntentions = Vec3();
-
-	if (leftStickMagnitude > 0.0f)
-	{
-		movementIntentions.y = -leftStick.GetPosition().x;
-		movementIntentions.x = leftStick.GetPosition().y;
-
-		m_velocity = Vec3(movementIntentions.x, movementIntentions.y, 0.0f) * m_panSpeed;
-	}
-
-	if (controller.IsButtonDown(XBOX_BUTTON_L))
-	{
-		movementIntentions.z += 1.0f;
-		m_velocity += Vec3(0.0f, 0.0f, movementIntentions.z) * m_panSpeed;
-	}
-	if (controller.IsButtonDown(XBOX_BUTTON_R))
-	{
-		movementIntentions.z -= 1.0f;
-		m_velocity += Vec3(0.0f, 0.0f, movementIntentions.z) * m_panSpeed;
-	}
-
-	if (controller.IsButtonDown(XBOX_BUTTON_A))
-	{
-		m_isSpeedUp = true;
-	}
-}
-
-
-void GameCamera::Render() const
-{
-}
+#include "Game/GameCamera.hpp"
+#include "Game/Game.hpp"
+#include "Game/Map.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Clock.hpp"
+#include "Engine/Input/InputSystem.hpp"
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Renderer/DebugRenderSystem.hpp"
+
+
+//
+//constructor
+//
+GameCamera::GameCamera(Game* owner)
+	:Entity(owner)
+{
+}
+
+
+//
+//public game flow functions
+//
+void GameCamera::Update()
+{
+	float systemDeltaSeconds = Clock::GetSystemClock().GetDeltaSeconds();
+
+	m_isSpeedUp = false;
+
+	Vec3 movementIntentions = Vec3();
+
+	if (g_theInput->IsKeyDown('W'))
+	{
+		movementIntentions.y += 1.0f;
+	}
+	if (g_theInput->IsKeyDown('S'))
+	{
+		movementIntentions.y -= 1.0f;
+	}
+	if (g_theInput->IsKeyDown('A'))
+	{
+		movementIntentions.x -= 1.0f;
+	}
+	if (g_theInput->IsKeyDown('D'))
+	{
+		movementIntentions.x += 1.0f;
+	}
+	if (g_theInput->IsKeyDown('Q'))
+	{
+		movementIntentions.z += 1.0f;
+	}
+	if (g_theInput->IsKeyDown('E'))
+	{
+		movementIntentions.z -= 1.0f;
+	}
+
+	if (g_theInput->IsKeyDown(KEYCODE_SHIFT))
+	{
+		m_isSpeedUp = true;
+	}
+
+	m_velocity = Vec3(movementIntentions.x, movementIntentions.y, 0.0f) * m_panSpeed;
+	m_velocity += Vec3(0.0f, 0.0f, movementIntentions.z) * m_elevateSpeed;
+
+	UpdateFromController();
+
+	if (m_isSpeedUp)
+	{
+		systemDeltaSeconds *= 10.0f;
+	}
+
+	m_position += m_velocity * systemDeltaSeconds;
+
+	//clamp camera according to min height, then world z, then projected world xy
+	m_position.z = GetClamped(m_position.z, m_minHeight, FLT_MAX);
+	MapDefinition const* mapDef = g_theGame->m_currentMap->m_definition;
+	m_position.z = GetClamped(m_position.z, mapDef->m_boundsMin.z, mapDef->m_boundsMax.z);
+	Vec3 raycastVector = GetModelMatrix().GetIBasis3D() * FLT_MAX;
+	float t = (-m_position.z) / raycastVector.z;
+	Vec3 posAtT = m_position + (raycastVector * t);
+	
+	float clampedX = GetClamped(posAtT.x, g_theGame->m_currentMap->m_definition->m_boundsMin.x, g_theGame->m_currentMap->m_definition->m_boundsMax.x);
+	float clampedY = GetClamped(posAtT.y, g_theGame->m_currentMap->m_definition->m_boundsMin.y, g_theGame->m_currentMap->m_definition->m_boundsMax.y);
+	float offsetX = posAtT.x - clampedX;
+	m_position.x -= offsetX;
+	float offsetY = posAtT.y - clampedY;
+	m_position.y -= offsetY;
+
+	m_camera.SetTransform(m_position, m_orientation);
+	UpdateFrustum();
+}
+
+
+void GameCamera::UpdateFromController()
+{
+	XboxController const& controller = g_theInput->GetController(0);
+	AnalogJoystick const& leftStick = controller.GetLeftStick();
+	float leftStickMagnitude = leftStick.GetMagnitude();
+
+	Vec3 movementIntentions = Vec3();
+
+	if (leftStickMagnitude > 0.0f)
+	{
+		movementIntentions.y = -leftStick.GetPosition().x;
+		movementIntentions.x = leftStick.GetPosition().y;
+
+		m_velocity = Vec3(movementIntentions.x, movementIntentions.y, 0.0f) * m_panSpeed;
+	}
+
+	if (controller.IsButtonDown(XBOX_BUTTON_L))
+	{
+		movementIntentions.z += 1.0f;
+		m_velocity += Vec3(0.0f, 0.0f, movementIntentions.z) * m_panSpeed;
+	}
+	if (controller.IsButtonDown(XBOX_BUTTON_R))
+	{
+		movementIntentions.z -= 1.0f;
+		m_velocity += Vec3(0.0f, 0.0f, movementIntentions.z) * m_panSpeed;
+	}
+
+	if (controller.IsButtonDown(XBOX_BUTTON_A))
+	{
+		m_isSpeedUp = true;
+	}
+}
+
+
+void GameCamera::Render() const
+{
+}
+
+
+//
+//public culling functions
+//
+void GameCamera::UpdateFrustum()
+{
+	Mat44 cameraMatrix = GetModelMatrix();
+	Vec3 forward = cameraMatrix.GetIBasis3D();
+	Vec3 left = cameraMatrix.GetJBasis3D();
+	Vec3 up = cameraMatrix.GetKBasis3D();
+
+	float nearClipDist = m_camera.GetPerspectiveNear();
+	float farClipDist = m_camera.GetPerspectiveFar();
+	float tanHalfFOV = TanDegrees(m_camera.GetPerspectiveFOV() * 0.5f);
+	float tanHalfHorizontalFOV = tanHalfFOV * m_camera.GetPerspectiveAspect();
+
+	//near and far
+	m_frustumNormals[0] = forward;
+	m_frustumDistances[0] = DotProduct3D(forward, m_position) + nearClipDist;
+	m_frustumNormals[1] = -forward;
+	m_frustumDistances[1] = -(DotProduct3D(forward, m_position) + farClipDist);
+
+	//left, right, top, bottom all pass through the camera position
+	m_frustumNormals[2] = (forward * tanHalfHorizontalFOV - left).GetNormalized();
+	m_frustumNormals[3] = (forward * tanHalfHorizontalFOV + left).GetNormalized();
+	m_frustumNormals[4] = (forward * tanHalfFOV - up).GetNormalized();
+	m_frustumNormals[5] = (forward * tanHalfFOV + up).GetNormalized();
+	for (int planeIndex = 2; planeIndex < 6; planeIndex++)
+	{
+		m_frustumDistances[planeIndex] = DotProduct3D(m_frustumNormals[planeIndex], m_position);
+	}
+}
+
+
+bool GameCamera::IsAABBInFrustum(Vec3 const& boundsMin, Vec3 const& boundsMax) const
+{
+	for (int planeIndex = 0; planeIndex < 6; planeIndex++)
+	{
+		//test the corner furthest along the plane normal
+		Vec3 const& normal = m_frustumNormals[planeIndex];
+		Vec3 farthestCorner;
+		farthestCorner.x = normal.x >= 0.0f ? boundsMax.x : boundsMin.x;
+		farthestCorner.y = normal.y >= 0.0f ? boundsMax.y : boundsMin.y;
+		farthestCorner.z = normal.z >= 0.0f ? boundsMax.z : boundsMin.z;
+
+		if (DotProduct3D(normal, farthestCorner) < m_frustumDistances[planeIndex])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+bool GameCamera::IsSphereInFrustum(Vec3 const& center, float radius) const
+{
+	for (int planeIndex = 0; planeIndex < 6; planeIndex++)
+	{
+		if (DotProduct3D(m_frustumNormals[planeIndex], center) - m_frustumDistances[planeIndex] < -radius)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+//
+//level of detail functions
+//
+float GameCamera::GetProjectedScreenFraction(Vec3 const& center, float radius) const
+{
+	//fraction of the screen height covered by the sphere's diameter
+	float distance = GetDistance3D(center, m_position);
+	if (distance <= radius)
+	{
+		return 1.0f;
+	}
+
+	float tanHalfFOV = TanDegrees(m_camera.GetPerspectiveFOV() * 0.5f);
+	return radius / (distance * tanHalfFOV);
+}
@@ -1,27 +1,39 @@
-#pragma once
-#include "Game/Entity.hpp"
-#include "Engine/Renderer/Camera.hpp"
-
-
-class GameCamera : public Entity
-{
-//public member functions
-public:
-	//constructor and destructor
-	GameCamera(Game* owner);
-
-	//game flow functions
-	virtual void Update() override;
-	void UpdateFromController();
-	virtual void Render() const override;
-
-//public member variables
-public:
-	Camera m_camera;
-
-	float m_panSpeed = 1.0f;
-	float m_elevateSpeed = 0.5f;
-	float m_minHeight = 0.0f;
-	float m_controllerTurnRate = 120.0f;
-	bool m_isSpeedUp = false;
-};
+#pragma once
+#include "Game/Entity.hpp"
+#include "Engine/Renderer/Camera.hpp"
+
+
+class GameCamera : public Entity
+{
+//public member functions
+public:
+	//constructor and destructor
+	GameCamera(Game* owner);
+
+	//game flow functions
+	virtual void Update() override;
+	void UpdateFromController();
+	virtual void Render() const override;
+
+	//culling functions
+	void UpdateFrustum();
+	bool IsAABBInFrustum(Vec3 const& boundsMin, Vec3 const& boundsMax) const;
+	bool IsSphereInFrustum(Vec3 const& center, float radius) const;
+
+	//level of detail functions
+	float GetProjectedScreenFraction(Vec3 const& center, float radius) const;
+
+//public member variables
+public:
+	Camera m_camera;
+
+	float m_panSpeed = 1.0f;
+	float m_elevateSpeed = 0.5f;
+	float m_minHeight = 0.0f;
+	float m_controllerTurnRate = 120.0f;
+	bool m_isSpeedUp = false;
+
+	//frustum planes, each one facing inwards (a point is inside a plane if dot(normal, point) >= distance)
+	Vec3  m_frustumNormals[6];
+	float m_frustumDistances[6] = {};
+};
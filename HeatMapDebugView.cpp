@@ -0,0 +1,136 @@
+#include "Game/HeatMapDebugView.hpp"
+#include "Game/Map.hpp"
+#include "Game/Game.hpp"
+#include "Game/GameCommon.hpp"
+#include "Game/RenderQueue.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/VertexBuffer.hpp"
+#include "Engine/Renderer/IndexBuffer.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+
+constexpr int HEAT_MAP_VERTS_PER_TEXEL = 4;
+constexpr float HEAT_MAP_TEXEL_HEIGHT = 0.01f;
+
+
+//
+//constructor and destructor
+//
+HeatMapDebugView::HeatMapDebugView(Map const* map)
+	: m_map(map)
+{
+	int numTiles = static_cast<int>(map->m_tiles.size());
+	m_verts.reserve(numTiles * HEAT_MAP_VERTS_PER_TEXEL);
+	m_indexes.reserve(numTiles * 6);
+
+	//one texel per tile, covering the tile's footprint in the hex layout
+	float texelHalfWidth = INRADIUS * 0.866f;
+	float texelHalfHeight = INRADIUS;
+	for (int tileIndex = 0; tileIndex < numTiles; tileIndex++)
+	{
+		Vec3 center = map->m_tiles[tileIndex].GetCenterPos();
+		center.z = HEAT_MAP_TEXEL_HEIGHT;
+
+		m_verts.emplace_back(Vertex_PCU(Vec3(center.x - texelHalfWidth, center.y - texelHalfHeight, center.z), HEAT_MAP_UNREACHABLE_COLOR));
+		m_verts.emplace_back(Vertex_PCU(Vec3(center.x + texelHalfWidth, center.y - texelHalfHeight, center.z), HEAT_MAP_UNREACHABLE_COLOR));
+		m_verts.emplace_back(Vertex_PCU(Vec3(center.x + texelHalfWidth, center.y + texelHalfHeight, center.z), HEAT_MAP_UNREACHABLE_COLOR));
+		m_verts.emplace_back(Vertex_PCU(Vec3(center.x - texelHalfWidth, center.y + texelHalfHeight, center.z), HEAT_MAP_UNREACHABLE_COLOR));
+
+		unsigned int firstVert = tileIndex * HEAT_MAP_VERTS_PER_TEXEL;
+		m_indexes.emplace_back(firstVert);
+		m_indexes.emplace_back(firstVert + 1);
+		m_indexes.emplace_back(firstVert + 2);
+		m_indexes.emplace_back(firstVert);
+		m_indexes.emplace_back(firstVert + 2);
+		m_indexes.emplace_back(firstVert + 3);
+	}
+
+	if (g_theRenderer == nullptr)
+	{
+		return;
+	}
+
+	m_vertexBuffer = g_theRenderer->CreateVertexBuffer(sizeof(Vertex_PCU), sizeof(Vertex_PCU));
+	m_indexBuffer = g_theRenderer->CreateIndexBuffer(sizeof(unsigned int));
+	g_theRenderer->CopyCPUToGPU(m_verts.data(), static_cast<int>(m_verts.size()) * sizeof(Vertex_PCU), m_vertexBuffer);
+	g_theRenderer->CopyCPUToGPU(m_indexes.data(), static_cast<int>(m_indexes.size()) * sizeof(unsigned int), m_indexBuffer);
+}
+
+
+HeatMapDebugView::~HeatMapDebugView()
+{
+	if (m_vertexBuffer != nullptr)
+	{
+		delete m_vertexBuffer;
+		m_vertexBuffer = nullptr;
+	}
+
+	if (m_indexBuffer != nullptr)
+	{
+		delete m_indexBuffer;
+		m_indexBuffer = nullptr;
+	}
+}
+
+
+//
+//debug view functions
+//
+void HeatMapDebugView::Render(TileHeatMap const& heatMap)
+{
+	//the field gets repopulated every frame while a unit is selected, so only recolor when the values actually differ
+	if (heatMap.m_values != m_displayedValues)
+	{
+		UpdateTexels(heatMap);
+	}
+
+	g_theGame->m_renderQueue->SubmitIndexedBuffer(RenderPass::TILE_OVERLAYS, nullptr, nullptr, DepthMode::DISABLED, m_vertexBuffer, m_indexBuffer,
+		static_cast<int>(m_indexes.size()));
+}
+
+
+//
+//private debug view functions
+//
+void HeatMapDebugView::UpdateTexels(TileHeatMap const& heatMap)
+{
+	m_displayedValues = heatMap.m_values;
+
+	//normalize against the farthest reachable tile so small fields still use the whole gradient
+	float maxReachableValue = 0.0f;
+	for (int valueIndex = 0; valueIndex < m_displayedValues.size(); valueIndex++)
+	{
+		float value = m_displayedValues[valueIndex];
+		if (value < HEAT_MAP_UNREACHABLE_VALUE && value > maxReachableValue)
+		{
+			maxReachableValue = value;
+		}
+	}
+
+	int numTexels = static_cast<int>(m_verts.size()) / HEAT_MAP_VERTS_PER_TEXEL;
+	for (int texelIndex = 0; texelIndex < numTexels && texelIndex < m_displayedValues.size(); texelIndex++)
+	{
+		float value = m_displayedValues[texelIndex];
+
+		Rgba8 color = HEAT_MAP_UNREACHABLE_COLOR;
+		if (value < HEAT_MAP_UNREACHABLE_VALUE)
+		{
+			float fractionOfMax = maxReachableValue > 0.0f ? value / maxReachableValue : 0.0f;
+			color.r = static_cast<unsigned char>(Interpolate(HEAT_MAP_NEAR_COLOR.r, HEAT_MAP_FAR_COLOR.r, fractionOfMax));
+			color.g = static_cast<unsigned char>(Interpolate(HEAT_MAP_NEAR_COLOR.g, HEAT_MAP_FAR_COLOR.g, fractionOfMax));
+			color.b = static_cast<unsigned char>(Interpolate(HEAT_MAP_NEAR_COLOR.b, HEAT_MAP_FAR_COLOR.b, fractionOfMax));
+			color.a = static_cast<unsigned char>(Interpolate(HEAT_MAP_NEAR_COLOR.a, HEAT_MAP_FAR_COLOR.a, fractionOfMax));
+		}
+
+		int firstVert = texelIndex * HEAT_MAP_VERTS_PER_TEXEL;
+		for (int vertIndex = firstVert; vertIndex < firstVert + HEAT_MAP_VERTS_PER_TEXEL; vertIndex++)
+		{
+			m_verts[vertIndex].m_color = color;
+		}
+	}
+
+	if (m_vertexBuffer != nullptr)
+	{
+		g_theRenderer->CopyCPUToGPU(m_verts.data(), static_cast<int>(m_verts.size()) * sizeof(Vertex_PCU), m_vertexBuffer);
+	}
+}
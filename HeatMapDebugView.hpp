@@ -0,0 +1,47 @@
+#pragma once
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Core/HeatMaps.hpp"
+
+
+//forward declarations
+class Map;
+class VertexBuffer;
+class IndexBuffer;
+
+
+constexpr float HEAT_MAP_UNREACHABLE_VALUE = 999.0f;
+
+static Rgba8 const HEAT_MAP_NEAR_COLOR = Rgba8(255, 255, 0, 160);
+static Rgba8 const HEAT_MAP_FAR_COLOR = Rgba8(0, 0, 255, 160);
+static Rgba8 const HEAT_MAP_UNREACHABLE_COLOR = Rgba8(0, 0, 0, 0);
+
+
+class HeatMapDebugView
+{
+//public member functions
+public:
+	//constructor and destructor
+	explicit HeatMapDebugView(Map const* map);
+	HeatMapDebugView(HeatMapDebugView const& copy) = delete;
+	~HeatMapDebugView();
+
+	//debug view functions
+	void Render(TileHeatMap const& heatMap);
+
+//public member variables
+public:
+	Map const* m_map = nullptr;
+
+	//one texel quad per tile, recolored only when the heat map's values change
+	std::vector<Vertex_PCU>	  m_verts;
+	std::vector<unsigned int> m_indexes;
+	VertexBuffer*			  m_vertexBuffer = nullptr;
+	IndexBuffer*			  m_indexBuffer = nullptr;
+
+	std::vector<float> m_displayedValues;
+
+//private member functions
+private:
+	void UpdateTexels(TileHeatMap const& heatMap);
+};
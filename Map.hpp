@@ -1,96 +1,172 @@
-#pragma once
-#include "Game/MapDefinition.hpp"
-#include "Game/Tile.hpp"
-#include "Game/Unit.hpp"
-#include "Engine/Core/EngineCommon.hpp"
-#include "Engine/Core/HeatMaps.hpp"
-
-
-class VertexBuffer;
-class IndexBuffer;
-struct Vertex_PCUTBN;
-
-
-enum class PlayerState
-{
-	READY,
-	SELECTING,
-	UNIT_SELECTED,
-	UNIT_MOVED,
-	UNIT_MOVE_CONFIRMED,
-	UNIT_ATTACKING,
-	ENDING_TURN,
-	WAITING
-};
-
-
-class Map
-{
-//public member functions
-public:
-	//constructor and destructor
-	Map(MapDefinition const* definition);
-	Map(Map const& copy) = delete;
-	~Map();
-
-	//game flow functions
-	void Update();
-	void Render() const;
-
-	//map utilities
-	Vec3 PerformMouseRaycast();
-	int  GetTileIndex(IntVec2 tileCoords) const;
-	bool IsTileInBounds(Tile const& tile) const;
-	bool IsTileSelectable(Tile const& tile) const;
-	void EndTurn();
-	Unit* GetUnitAtCoords(IntVec2 tileCoords, int player) const;
-	void RevertOrders();
-	void AttemptMove();
-	void ConfirmMove();
-	void AttemptAttack();
-	void AttackTargetedUnit();
-	void KillUnit(Unit* unit);
-	void PopulateDistanceField(TileHeatMap& outDistanceField, IntVec2 const& referenceCoords);
-
-	//network commands
-	static bool Event_StartTurn(EventArgs& args);
-	static bool Event_SelectHex(EventArgs& args);
-	static bool Event_SelectUnit(EventArgs& args);
-	static bool Event_SelectFirstUnit(EventArgs& args);
-	static bool Event_SelectLastUnit(EventArgs& args);
-	static bool Event_SelectPreviousUnit(EventArgs& args);
-	static bool Event_SelectNextUnit(EventArgs& args);
-	static bool Event_MoveUnit(EventArgs& args);
-	static bool Event_ConfirmMove(EventArgs& args);
-	static bool Event_NoAttack(EventArgs& args);
-	static bool Event_Attack(EventArgs& args);
-	static bool Event_ConfirmAttack(EventArgs& args);
-	static bool Event_CancelMove(EventArgs& args);
-	static bool Event_EndTurn(EventArgs& args);
-	static bool Event_ConfirmEnd(EventArgs& args);
-	static bool Event_CancelEnd(EventArgs& args);
-
-//public member variables
-public:
-	MapDefinition const* m_definition = nullptr;
-
-	std::vector<Tile> m_tiles;
-	IntVec2 m_selectedTileCoords = IntVec2(-1, -1);
-	TileHeatMap m_distanceFieldFromSelectedUnit;
-
-	int m_currentPlayerTurn = 1;
-	PlayerState m_playerState = PlayerState::READY;
-
-	mutable std::vector<Unit> m_player1Units;
-	mutable std::vector<Unit> m_player2Units;
-
-	std::vector<Vertex_PCUTBN>  m_tileVerts;
-	std::vector<unsigned int> m_tileVertIndexes;
-	VertexBuffer*			  m_tileVertBuffer;
-	IndexBuffer*			  m_tileIndexBuffer;
-
-	Unit* m_selectedUnit = nullptr;
-	Unit* m_targetedUnit = nullptr;
-
-	IntVec2 m_previousUnitTileCoords = IntVec2(-1, -1);
-};
+#pragma once
+#include "Game/MapDefinition.hpp"
+#include "Game/Tile.hpp"
+#include "Game/Unit.hpp"
+#include "Game/Model.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/HeatMaps.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include <cstdint>
+
+
+class VertexBuffer;
+class IndexBuffer;
+class Minimap;
+class HeatMapDebugView;
+class SoftwareRenderer;
+struct SoftwareTexture;
+
+
+constexpr int TILE_CHUNK_SIZE = 8;
+
+
+struct TileChunk
+{
+	Vec3 m_boundsMin = Vec3();
+	Vec3 m_boundsMax = Vec3();
+
+	std::vector<Vertex_PCU> m_verts;
+	std::vector<unsigned int>  m_indexes;
+	VertexBuffer*			   m_vertexBuffer = nullptr;
+	IndexBuffer*			   m_indexBuffer = nullptr;
+};
+
+
+enum class PlayerState
+{
+	READY,
+	SELECTING,
+	UNIT_SELECTED,
+	UNIT_MOVED,
+	UNIT_MOVE_CONFIRMED,
+	UNIT_ATTACKING,
+	ENDING_TURN,
+	WAITING
+};
+
+
+class Map
+{
+//public member functions
+public:
+	//constructor and destructor
+	Map(MapDefinition const* definition);
+	Map(Map const& copy) = delete;
+	~Map();
+
+	//game flow functions
+	void Update();
+	void UpdateHoverStreaming(int hoveredTileIndex);
+	void Render() const;
+	void RenderTiles() const;
+	void RenderUnits() const;
+	void RenderMinimap() const;
+	void RenderSoftware(SoftwareRenderer& renderer, SoftwareTexture const* groundTexture) const;
+
+	//map utilities
+	Vec3 PerformMouseRaycast();
+	int  GetTileIndex(IntVec2 tileCoords) const;
+	int  GetTileChunkIndex(IntVec2 tileCoords) const;
+	int  GetTileSlotIndex(IntVec2 tileCoords) const;
+	void WriteTileSlot(Tile const& tile);
+	void UploadTileChunk(int chunkIndex);
+	void SetTileDefinition(IntVec2 tileCoords, TileDefinition const* definition);
+	bool IsTileInBounds(Tile const& tile) const;
+	bool IsTileSelectable(Tile const& tile) const;
+	void SelectHex(int tileIndex);
+	void EndTurn();
+	Unit* GetUnitAtCoords(IntVec2 tileCoords, int player) const;
+	void RevertOrders();
+	void AttemptMove();
+	void ConfirmMove();
+	void AttemptAttack();
+	void AttackTargetedUnit();
+	void KillUnit(Unit* unit);
+	void RefreshSelectedUnitState();
+	void PopulateDistanceField(TileHeatMap& outDistanceField, IntVec2 const& referenceCoords);
+
+	//state hashing functions, every change to hashed state goes through these so the hash stays current in O(1)
+	uint64_t ComputeStateHash() const;
+	void	 ResetStateHash();
+	void	 SetPlayerState(PlayerState state);
+	void	 SetCurrentPlayerTurn(int player);
+	void	 SetUnitCoords(Unit& unit, IntVec2 coords);
+	void	 SetUnitHealth(Unit& unit, int health);
+	void	 SetUnitMoved(Unit& unit, bool movedThisTurn);
+	void	 ClearMovedFlags(int player);
+
+	//network commands
+	static bool Event_StartTurn(EventArgs& args);
+	static bool Event_SelectHex(EventArgs& args);
+	static bool Event_SelectUnit(EventArgs& args);
+	static bool Event_SelectFirstUnit(EventArgs& args);
+	static bool Event_SelectLastUnit(EventArgs& args);
+	static bool Event_SelectPreviousUnit(EventArgs& args);
+	static bool Event_SelectNextUnit(EventArgs& args);
+	static bool Event_MoveUnit(EventArgs& args);
+	static bool Event_ConfirmMove(EventArgs& args);
+	static bool Event_NoAttack(EventArgs& args);
+	static bool Event_Attack(EventArgs& args);
+	static bool Event_ConfirmAttack(EventArgs& args);
+	static bool Event_CancelMove(EventArgs& args);
+	static bool Event_EndTurn(EventArgs& args);
+	static bool Event_ConfirmEnd(EventArgs& args);
+	static bool Event_CancelEnd(EventArgs& args);
+
+	//editor commands
+	static bool Event_SetTile(EventArgs& args);
+
+//public member variables
+public:
+	MapDefinition const* m_definition = nullptr;
+
+	std::vector<Tile> m_tiles;
+	IntVec2 m_selectedTileCoords = IntVec2(-1, -1);
+	TileHeatMap m_distanceFieldFromSelectedUnit;
+
+	int m_currentPlayerTurn = 1;
+	PlayerState m_playerState = PlayerState::READY;
+
+	mutable std::vector<Unit> m_player1Units;
+	mutable std::vector<Unit> m_player2Units;
+
+	std::vector<Vertex_PCU> m_groundVerts;
+
+	IntVec2				   m_tileChunkGridSize = IntVec2();
+	std::vector<TileChunk> m_tileChunks;
+
+	//scratch buffers for building a single tile slot
+	std::vector<Vertex_PCU> m_tileSlotVerts;
+	std::vector<unsigned int>  m_tileSlotIndexes;
+
+	Unit* m_selectedUnit = nullptr;
+	Unit* m_targetedUnit = nullptr;
+
+	IntVec2 m_previousUnitTileCoords = IntVec2(-1, -1);
+
+	//zobrist hash of unit coords, health, and moved flags, the current turn, and the player state
+	//moved flags are also kept per player, so clearing a whole side's flags at the end of a turn is one xor
+	uint64_t m_stateHash = 0;
+	uint64_t m_movedHashByPlayer[2] = {};
+
+	//overlay verts for this frame, kept alive until the render queue is flushed
+	mutable FrameVector<Vertex_PCU> m_selectedTileVerts;
+	mutable FrameVector<Vertex_PCU> m_selectedUnitTileVerts;
+
+	//unit instance lists per definition, with the LOD each instance is drawn at this frame or -1 if it's culled, reused every frame
+	mutable std::vector<std::vector<ModelInstance>> m_unitInstancesByDefinition;
+	mutable std::vector<std::vector<int>>			m_unitLODsByDefinition;
+
+	//hover is only streamed when it changes, and no faster than the configured rate
+	int	   m_lastSentHoverTileIndex = -2;
+	int	   m_lastHoveredTileIndex = -2;
+	double m_lastHoverSendTime = 0.0;
+	double m_hoverSendInterval = 0.05;
+
+	//retained minimap, only tiles marked dirty get recolored
+	Minimap* m_minimap = nullptr;
+
+	//debug views
+	bool			  m_isDistanceFieldVisible = false;
+	HeatMapDebugView* m_distanceFieldDebugView = nullptr;
+};
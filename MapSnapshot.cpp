@@ -0,0 +1,427 @@
+#include "Game/MapSnapshot.hpp"
+#include "Game/Minimap.hpp"
+#include "Game/NetProtocol.hpp"
+#include "Engine/Core/StringUtils.hpp"
+
+
+constexpr int NUM_STATE_HASH_BYTES = 8;
+
+
+static char const* GetPlayerStateName(PlayerState state)
+{
+	switch (state)
+	{
+		case PlayerState::READY:				return "READY";
+		case PlayerState::SELECTING:			return "SELECTING";
+		case PlayerState::UNIT_SELECTED:		return "UNIT_SELECTED";
+		case PlayerState::UNIT_MOVED:			return "UNIT_MOVED";
+		case PlayerState::UNIT_MOVE_CONFIRMED:	return "UNIT_MOVE_CONFIRMED";
+		case PlayerState::UNIT_ATTACKING:		return "UNIT_ATTACKING";
+		case PlayerState::ENDING_TURN:			return "ENDING_TURN";
+		case PlayerState::WAITING:				return "WAITING";
+		default:								return "UNKNOWN";
+	}
+}
+
+
+static void AppendCoords(std::string& bytes, IntVec2 const& coords)
+{
+	AppendVarint(bytes, ZigZagEncode(coords.x));
+	AppendVarint(bytes, ZigZagEncode(coords.y));
+}
+
+
+static bool ReadCoords(unsigned char const* bytes, size_t numBytes, size_t& inoutOffset, IntVec2& outCoords)
+{
+	uint32_t x = 0;
+	uint32_t y = 0;
+	if (!ReadVarint(bytes, numBytes, inoutOffset, x) || !ReadVarint(bytes, numBytes, inoutOffset, y))
+	{
+		return false;
+	}
+
+	outCoords = IntVec2(ZigZagDecode(x), ZigZagDecode(y));
+	return true;
+}
+
+
+static void AppendUnitReference(std::string& bytes, int ownerID, int unitID)
+{
+	bytes.push_back(static_cast<char>(ownerID));
+	if (ownerID != 0)
+	{
+		AppendVarint(bytes, static_cast<uint32_t>(unitID));
+	}
+}
+
+
+static bool ReadUnitReference(unsigned char const* bytes, size_t numBytes, size_t& inoutOffset, int& outOwnerID, int& outUnitID)
+{
+	if (inoutOffset >= numBytes)
+	{
+		return false;
+	}
+
+	outOwnerID = bytes[inoutOffset++];
+	outUnitID = 0;
+	if (outOwnerID == 0)
+	{
+		return true;
+	}
+
+	uint32_t unitID = 0;
+	if (!ReadVarint(bytes, numBytes, inoutOffset, unitID))
+	{
+		return false;
+	}
+	outUnitID = static_cast<int>(unitID);
+	return true;
+}
+
+
+static Unit* FindUnit(Map& map, int ownerID, int unitID)
+{
+	std::vector<Unit>& units = ownerID == 1 ? map.m_player1Units : map.m_player2Units;
+	for (int unitIndex = 0; unitIndex < units.size(); unitIndex++)
+	{
+		if (units[unitIndex].m_unitID == unitID)
+		{
+			return &units[unitIndex];
+		}
+	}
+
+	return nullptr;
+}
+
+
+static bool IsOnGrid(Map const& map, IntVec2 const& coords)
+{
+	IntVec2 const& gridSize = map.m_definition->m_gridSize;
+	return coords.x >= 0 && coords.y >= 0 && coords.x < gridSize.x && coords.y < gridSize.y;
+}
+
+
+static bool IsOnGridOrNone(Map const& map, IntVec2 const& coords)
+{
+	return coords == IntVec2(-1, -1) || IsOnGrid(map, coords);
+}
+
+
+static bool HasUnit(std::vector<UnitSnapshot> const& units, int ownerID, int unitID)
+{
+	for (int unitIndex = 0; unitIndex < units.size(); unitIndex++)
+	{
+		if (units[unitIndex].m_ownerID == ownerID && units[unitIndex].m_unitID == unitID)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+//
+//capture functions
+//
+void MapSnapshot::Capture(Map const& map, int commandIndex)
+{
+	m_commandIndex = commandIndex;
+	m_stateHash = map.m_stateHash;
+	m_currentPlayerTurn = map.m_currentPlayerTurn;
+	m_playerState = map.m_playerState;
+
+	m_selectedTileCoords = map.m_selectedTileCoords;
+	m_previousUnitTileCoords = map.m_previousUnitTileCoords;
+	m_selectedUnitOwnerID = map.m_selectedUnit != nullptr ? map.m_selectedUnit->m_ownerID : 0;
+	m_selectedUnitID = map.m_selectedUnit != nullptr ? map.m_selectedUnit->m_unitID : 0;
+	m_targetedUnitOwnerID = map.m_targetedUnit != nullptr ? map.m_targetedUnit->m_ownerID : 0;
+	m_targetedUnitID = map.m_targetedUnit != nullptr ? map.m_targetedUnit->m_unitID : 0;
+
+	m_units.clear();
+	std::vector<Unit> const* unitLists[] = { &map.m_player1Units, &map.m_player2Units };
+	for (int listIndex = 0; listIndex < 2; listIndex++)
+	{
+		std::vector<Unit> const& units = *unitLists[listIndex];
+		for (int unitIndex = 0; unitIndex < units.size(); unitIndex++)
+		{
+			UnitSnapshot unit;
+			unit.m_ownerID = units[unitIndex].m_ownerID;
+			unit.m_unitID = units[unitIndex].m_unitID;
+			unit.m_coords = units[unitIndex].m_coords;
+			unit.m_currentHealth = units[unitIndex].m_currentHealth;
+			unit.m_movedThisTurn = units[unitIndex].m_movedThisTurn;
+			m_units.emplace_back(unit);
+		}
+	}
+}
+
+
+bool MapSnapshot::Apply(Map& map) const
+{
+	//units are only ever created with the map, so a fresh map of the same definition has every unit the snapshot can name
+	//check everything before touching anything, so a snapshot that doesn't fit leaves the map as it was
+	for (int unitIndex = 0; unitIndex < m_units.size(); unitIndex++)
+	{
+		UnitSnapshot const& unit = m_units[unitIndex];
+		if ((unit.m_ownerID != 1 && unit.m_ownerID != 2) || FindUnit(map, unit.m_ownerID, unit.m_unitID) == nullptr || !IsOnGrid(map, unit.m_coords))
+		{
+			return false;
+		}
+
+		//strictly increasing by owner then ID, which also rules out the same unit twice
+		if (unitIndex > 0)
+		{
+			UnitSnapshot const& previousUnit = m_units[unitIndex - 1];
+			if (unit.m_ownerID < previousUnit.m_ownerID || (unit.m_ownerID == previousUnit.m_ownerID && unit.m_unitID <= previousUnit.m_unitID))
+			{
+				return false;
+			}
+		}
+	}
+
+	if ((m_currentPlayerTurn != 1 && m_currentPlayerTurn != 2) || !IsOnGridOrNone(map, m_selectedTileCoords) || !IsOnGridOrNone(map, m_previousUnitTileCoords))
+	{
+		return false;
+	}
+
+	//the unit references have to name units that are still alive, and the states that act on a selected or targeted unit need one
+	bool needsSelectedUnit = m_playerState == PlayerState::UNIT_SELECTED || m_playerState == PlayerState::UNIT_MOVED || m_playerState == PlayerState::UNIT_MOVE_CONFIRMED ||
+		m_playerState == PlayerState::UNIT_ATTACKING;
+	bool needsTargetedUnit = m_playerState == PlayerState::UNIT_ATTACKING;
+	if ((m_selectedUnitOwnerID != 0 && !HasUnit(m_units, m_selectedUnitOwnerID, m_selectedUnitID)) || (needsSelectedUnit && m_selectedUnitOwnerID == 0) ||
+		(m_targetedUnitOwnerID != 0 && !HasUnit(m_units, m_targetedUnitOwnerID, m_targetedUnitID)) || (needsTargetedUnit && m_targetedUnitOwnerID == 0))
+	{
+		return false;
+	}
+
+	//the old positions need redrawing on the minimap as well as the new ones
+	for (int tileIndex = 0; tileIndex < map.m_tiles.size(); tileIndex++)
+	{
+		map.m_minimap->MarkTileDirty(map.m_tiles[tileIndex].m_coords);
+	}
+
+	//keep the units named in the snapshot, in order, and drop the ones that have died since the map was created
+	//each list is rebuilt from copies, since filling it in place could overwrite a unit before it's been copied
+	std::vector<Unit>* unitLists[] = { &map.m_player1Units, &map.m_player2Units };
+	for (int listIndex = 0; listIndex < 2; listIndex++)
+	{
+		std::vector<Unit> keptUnits;
+		keptUnits.reserve(unitLists[listIndex]->size());
+		for (int unitIndex = 0; unitIndex < m_units.size(); unitIndex++)
+		{
+			UnitSnapshot const& snapshotUnit = m_units[unitIndex];
+			if (snapshotUnit.m_ownerID != listIndex + 1)
+			{
+				continue;
+			}
+
+			keptUnits.emplace_back(*FindUnit(map, snapshotUnit.m_ownerID, snapshotUnit.m_unitID));
+			keptUnits.back().m_coords = snapshotUnit.m_coords;
+			keptUnits.back().m_currentHealth = snapshotUnit.m_currentHealth;
+			keptUnits.back().m_movedThisTurn = snapshotUnit.m_movedThisTurn;
+		}
+		unitLists[listIndex]->swap(keptUnits);
+	}
+
+	map.m_currentPlayerTurn = m_currentPlayerTurn;
+	map.m_playerState = m_playerState;
+	map.m_selectedTileCoords = m_selectedTileCoords;
+	map.m_previousUnitTileCoords = m_previousUnitTileCoords;
+	map.m_selectedUnit = m_selectedUnitOwnerID != 0 ? FindUnit(map, m_selectedUnitOwnerID, m_selectedUnitID) : nullptr;
+	map.m_targetedUnit = m_targetedUnitOwnerID != 0 ? FindUnit(map, m_targetedUnitOwnerID, m_targetedUnitID) : nullptr;
+
+	//the distance field is derived state, so it's rebuilt rather than sent
+	map.RefreshSelectedUnitState();
+
+	//everything changed at once, so the hash is rebuilt rather than updated
+	map.ResetStateHash();
+	return true;
+}
+
+
+//
+//serialization functions
+//
+void MapSnapshot::Serialize(std::string& outBytes) const
+{
+	outBytes.push_back(static_cast<char>(MAP_SNAPSHOT_VERSION));
+	AppendVarint(outBytes, ZigZagEncode(m_commandIndex));
+	for (int byteIndex = 0; byteIndex < NUM_STATE_HASH_BYTES; byteIndex++)
+	{
+		outBytes.push_back(static_cast<char>((m_stateHash >> (byteIndex * 8)) & 0xFF));
+	}
+
+	//turn and player state share a byte
+	outBytes.push_back(static_cast<char>((m_currentPlayerTurn & 0x3) | (static_cast<int>(m_playerState) << 2)));
+
+	AppendCoords(outBytes, m_selectedTileCoords);
+	AppendCoords(outBytes, m_previousUnitTileCoords);
+	AppendUnitReference(outBytes, m_selectedUnitOwnerID, m_selectedUnitID);
+	AppendUnitReference(outBytes, m_targetedUnitOwnerID, m_targetedUnitID);
+
+	AppendVarint(outBytes, m_senderNextLocalSequence);
+	AppendVarint(outBytes, m_senderNextRemoteSequence);
+
+	//owner and moved flag share a byte, everything else is a varint that's a single byte on any map this game ships with
+	AppendVarint(outBytes, static_cast<uint32_t>(m_units.size()));
+	for (int unitIndex = 0; unitIndex < m_units.size(); unitIndex++)
+	{
+		UnitSnapshot const& unit = m_units[unitIndex];
+		outBytes.push_back(static_cast<char>((unit.m_ownerID << 1) | (unit.m_movedThisTurn ? 1 : 0)));
+		AppendVarint(outBytes, static_cast<uint32_t>(unit.m_unitID));
+		AppendCoords(outBytes, unit.m_coords);
+		AppendVarint(outBytes, ZigZagEncode(unit.m_currentHealth));
+	}
+}
+
+
+bool MapSnapshot::Deserialize(std::string_view bytes)
+{
+	unsigned char const* data = reinterpret_cast<unsigned char const*>(bytes.data());
+	size_t numBytes = bytes.size();
+	size_t offset = 0;
+	uint32_t value = 0;
+
+	if (numBytes == 0 || data[offset++] != MAP_SNAPSHOT_VERSION)
+	{
+		return false;
+	}
+
+	if (!ReadVarint(data, numBytes, offset, value))
+	{
+		return false;
+	}
+	m_commandIndex = ZigZagDecode(value);
+
+	if (numBytes - offset < NUM_STATE_HASH_BYTES + 1)
+	{
+		return false;
+	}
+	m_stateHash = 0;
+	for (int byteIndex = 0; byteIndex < NUM_STATE_HASH_BYTES; byteIndex++)
+	{
+		m_stateHash |= static_cast<uint64_t>(data[offset++]) << (byteIndex * 8);
+	}
+
+	unsigned char turnAndState = data[offset++];
+	m_currentPlayerTurn = turnAndState & 0x3;
+	m_playerState = static_cast<PlayerState>(turnAndState >> 2);
+	if (m_playerState > PlayerState::WAITING)
+	{
+		return false;
+	}
+
+	if (!ReadCoords(data, numBytes, offset, m_selectedTileCoords) || !ReadCoords(data, numBytes, offset, m_previousUnitTileCoords) ||
+		!ReadUnitReference(data, numBytes, offset, m_selectedUnitOwnerID, m_selectedUnitID) || !ReadUnitReference(data, numBytes, offset, m_targetedUnitOwnerID, m_targetedUnitID) ||
+		!ReadVarint(data, numBytes, offset, m_senderNextLocalSequence) || !ReadVarint(data, numBytes, offset, m_senderNextRemoteSequence))
+	{
+		return false;
+	}
+
+	uint32_t numUnits = 0;
+	if (!ReadVarint(data, numBytes, offset, numUnits) || numUnits > numBytes - offset)
+	{
+		return false;
+	}
+
+	m_units.clear();
+	m_units.reserve(numUnits);
+	for (uint32_t unitIndex = 0; unitIndex < numUnits; unitIndex++)
+	{
+		if (offset >= numBytes)
+		{
+			return false;
+		}
+
+		UnitSnapshot unit;
+		unsigned char ownerAndMoved = data[offset++];
+		unit.m_ownerID = ownerAndMoved >> 1;
+		unit.m_movedThisTurn = (ownerAndMoved & 1) != 0;
+
+		uint32_t unitID = 0;
+		uint32_t health = 0;
+		if (!ReadVarint(data, numBytes, offset, unitID) || !ReadCoords(data, numBytes, offset, unit.m_coords) || !ReadVarint(data, numBytes, offset, health))
+		{
+			return false;
+		}
+		unit.m_unitID = static_cast<int>(unitID);
+		unit.m_currentHealth = ZigZagDecode(health);
+		m_units.emplace_back(unit);
+	}
+
+	return offset == numBytes;
+}
+
+
+//
+//comparison functions
+//
+void MapSnapshot::AppendDiff(MapSnapshot const& remote, std::vector<std::string>& outLines) const
+{
+	outLines.emplace_back(Stringf(" State hash:   local %016llx, remote %016llx", static_cast<unsigned long long>(m_stateHash), static_cast<unsigned long long>(remote.m_stateHash)));
+	outLines.emplace_back(Stringf(" Captured at:  local command %i, remote command %i", m_commandIndex, remote.m_commandIndex));
+
+	if (m_currentPlayerTurn != remote.m_currentPlayerTurn)
+	{
+		outLines.emplace_back(Stringf(" Turn:         local player %i, remote player %i", m_currentPlayerTurn, remote.m_currentPlayerTurn));
+	}
+	if (m_playerState != remote.m_playerState)
+	{
+		outLines.emplace_back(Stringf(" Player state: local %s, remote %s", GetPlayerStateName(m_playerState), GetPlayerStateName(remote.m_playerState)));
+	}
+	if (m_selectedTileCoords != remote.m_selectedTileCoords)
+	{
+		outLines.emplace_back(Stringf(" Selected tile: local (%i, %i), remote (%i, %i)", m_selectedTileCoords.x, m_selectedTileCoords.y, remote.m_selectedTileCoords.x, remote.m_selectedTileCoords.y));
+	}
+	if (m_selectedUnitOwnerID != remote.m_selectedUnitOwnerID || m_selectedUnitID != remote.m_selectedUnitID)
+	{
+		outLines.emplace_back(Stringf(" Selected unit: local P%i#%i, remote P%i#%i", m_selectedUnitOwnerID, m_selectedUnitID, remote.m_selectedUnitOwnerID, remote.m_selectedUnitID));
+	}
+	if (m_targetedUnitOwnerID != remote.m_targetedUnitOwnerID || m_targetedUnitID != remote.m_targetedUnitID)
+	{
+		outLines.emplace_back(Stringf(" Targeted unit: local P%i#%i, remote P%i#%i", m_targetedUnitOwnerID, m_targetedUnitID, remote.m_targetedUnitOwnerID, remote.m_targetedUnitID));
+	}
+
+	//both lists are ordered by owner then unit ID, so walk them side by side
+	int localIndex = 0;
+	int remoteIndex = 0;
+	while (localIndex < m_units.size() || remoteIndex < remote.m_units.size())
+	{
+		UnitSnapshot const* localUnit = localIndex < m_units.size() ? &m_units[localIndex] : nullptr;
+		UnitSnapshot const* remoteUnit = remoteIndex < remote.m_units.size() ? &remote.m_units[remoteIndex] : nullptr;
+
+		if (remoteUnit == nullptr || (localUnit != nullptr && (localUnit->m_ownerID < remoteUnit->m_ownerID ||
+			(localUnit->m_ownerID == remoteUnit->m_ownerID && localUnit->m_unitID < remoteUnit->m_unitID))))
+		{
+			outLines.emplace_back(Stringf(" Unit P%i#%i:   only alive locally, at (%i, %i) with %i health", localUnit->m_ownerID, localUnit->m_unitID, localUnit->m_coords.x, localUnit->m_coords.y,
+				localUnit->m_currentHealth));
+			localIndex++;
+			continue;
+		}
+		if (localUnit == nullptr || localUnit->m_ownerID != remoteUnit->m_ownerID || localUnit->m_unitID != remoteUnit->m_unitID)
+		{
+			outLines.emplace_back(Stringf(" Unit P%i#%i:   only alive remotely, at (%i, %i) with %i health", remoteUnit->m_ownerID, remoteUnit->m_unitID, remoteUnit->m_coords.x, remoteUnit->m_coords.y,
+				remoteUnit->m_currentHealth));
+			remoteIndex++;
+			continue;
+		}
+
+		if (localUnit->m_coords != remoteUnit->m_coords)
+		{
+			outLines.emplace_back(Stringf(" Unit P%i#%i:   coords local (%i, %i), remote (%i, %i)", localUnit->m_ownerID, localUnit->m_unitID, localUnit->m_coords.x, localUnit->m_coords.y,
+				remoteUnit->m_coords.x, remoteUnit->m_coords.y));
+		}
+		if (localUnit->m_currentHealth != remoteUnit->m_currentHealth)
+		{
+			outLines.emplace_back(Stringf(" Unit P%i#%i:   health local %i, remote %i", localUnit->m_ownerID, localUnit->m_unitID, localUnit->m_currentHealth, remoteUnit->m_currentHealth));
+		}
+		if (localUnit->m_movedThisTurn != remoteUnit->m_movedThisTurn)
+		{
+			outLines.emplace_back(Stringf(" Unit P%i#%i:   moved local %s, remote %s", localUnit->m_ownerID, localUnit->m_unitID, localUnit->m_movedThisTurn ? "yes" : "no",
+				remoteUnit->m_movedThisTurn ? "yes" : "no"));
+		}
+		localIndex++;
+		remoteIndex++;
+	}
+}
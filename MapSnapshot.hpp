@@ -0,0 +1,51 @@
+#pragma once
+#include "Game/Map.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+constexpr unsigned char MAP_SNAPSHOT_VERSION = 1;
+
+
+struct UnitSnapshot
+{
+	int		m_ownerID = 1;
+	int		m_unitID = 0;
+	IntVec2 m_coords = IntVec2();
+	int		m_currentHealth = 0;
+	bool	m_movedThisTurn = false;
+};
+
+
+//everything needed to put a map back into the middle of a match: the hashed state plus the current selection
+//units are kept in the same order as the map's lists, player 1 first, each list in unit ID order
+//a unit reference is its owner and ID, with an owner of 0 meaning no unit
+struct MapSnapshot
+{
+	void Capture(Map const& map, int commandIndex);
+	bool Apply(Map& map) const;
+	void Serialize(std::string& outBytes) const;
+	bool Deserialize(std::string_view bytes);
+	void AppendDiff(MapSnapshot const& remote, std::vector<std::string>& outLines) const;
+
+	int		 m_commandIndex = -1;
+	uint64_t m_stateHash = 0;
+
+	int			m_currentPlayerTurn = 1;
+	PlayerState m_playerState = PlayerState::READY;
+
+	IntVec2 m_selectedTileCoords = IntVec2(-1, -1);
+	IntVec2 m_previousUnitTileCoords = IntVec2(-1, -1);
+	int		m_selectedUnitOwnerID = 0;
+	int		m_selectedUnitID = 0;
+	int		m_targetedUnitOwnerID = 0;
+	int		m_targetedUnitID = 0;
+
+	//filled in by the sender of a resync, so the receiver picks up both command streams where the sender left them
+	uint32_t m_senderNextLocalSequence = 0;
+	uint32_t m_senderNextRemoteSequence = 0;
+
+	std::vector<UnitSnapshot> m_units;
+};
@@ -0,0 +1,307 @@
+#include "Game/MeshOptimizer.hpp"
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+
+constexpr int FORSYTH_CACHE_SIZE = 32;
+constexpr float FORSYTH_LAST_TRIANGLE_SCORE = 0.75f;
+constexpr float FORSYTH_CACHE_DECAY_POWER = 1.5f;
+constexpr float FORSYTH_VALENCE_BOOST_SCALE = 2.0f;
+constexpr float FORSYTH_VALENCE_BOOST_POWER = 0.5f;
+
+
+//
+//helper functions
+//
+static size_t HashVertex(Vertex_PCUTBN const& vert)
+{
+	//FNV-1a over the raw bytes, since welding only merges bitwise identical vertices
+	unsigned char const* bytes = reinterpret_cast<unsigned char const*>(&vert);
+	size_t hash = 14695981039346656037ull;
+	for (int byteIndex = 0; byteIndex < sizeof(Vertex_PCUTBN); byteIndex++)
+	{
+		hash ^= bytes[byteIndex];
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+
+static float GetForsythVertexScore(int cachePosition, int numRemainingTriangles)
+{
+	if (numRemainingTriangles == 0)
+	{
+		return -1.0f;
+	}
+
+	float score = 0.0f;
+	if (cachePosition >= 0)
+	{
+		//the last triangle's vertices get a fixed score so the next triangle doesn't just reuse the same edge
+		if (cachePosition < 3)
+		{
+			score = FORSYTH_LAST_TRIANGLE_SCORE;
+		}
+		else
+		{
+			float scaler = 1.0f / static_cast<float>(FORSYTH_CACHE_SIZE - 3);
+			score = powf(1.0f - static_cast<float>(cachePosition - 3) * scaler, FORSYTH_CACHE_DECAY_POWER);
+		}
+	}
+
+	//favor vertices with few triangles left so they get finished off instead of stranded
+	score += FORSYTH_VALENCE_BOOST_SCALE * powf(static_cast<float>(numRemainingTriangles), -FORSYTH_VALENCE_BOOST_POWER);
+	return score;
+}
+
+
+//
+//public functions
+//
+void WeldVertices(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigned int>& indexes)
+{
+	std::vector<unsigned int> sourceIndexes = indexes;
+	if (sourceIndexes.empty())
+	{
+		for (unsigned int vertIndex = 0; vertIndex < verts.size(); vertIndex++)
+		{
+			sourceIndexes.emplace_back(vertIndex);
+		}
+	}
+
+	std::vector<Vertex_PCUTBN> weldedVerts;
+	weldedVerts.reserve(verts.size());
+	std::vector<int> weldedIndexByVert(verts.size(), -1);
+	std::unordered_multimap<size_t, unsigned int> weldedIndexesByHash;
+	weldedIndexesByHash.reserve(verts.size());
+
+	for (int vertIndex = 0; vertIndex < verts.size(); vertIndex++)
+	{
+		Vertex_PCUTBN const& vert = verts[vertIndex];
+		size_t hash = HashVertex(vert);
+
+		auto range = weldedIndexesByHash.equal_range(hash);
+		for (auto iter = range.first; iter != range.second; ++iter)
+		{
+			if (memcmp(&weldedVerts[iter->second], &vert, sizeof(Vertex_PCUTBN)) == 0)
+			{
+				weldedIndexByVert[vertIndex] = iter->second;
+				break;
+			}
+		}
+
+		if (weldedIndexByVert[vertIndex] < 0)
+		{
+			weldedIndexByVert[vertIndex] = static_cast<int>(weldedVerts.size());
+			weldedIndexesByHash.insert({ hash, static_cast<unsigned int>(weldedVerts.size()) });
+			weldedVerts.emplace_back(vert);
+		}
+	}
+
+	indexes.resize(sourceIndexes.size());
+	for (int indexIndex = 0; indexIndex < sourceIndexes.size(); indexIndex++)
+	{
+		indexes[indexIndex] = static_cast<unsigned int>(weldedIndexByVert[sourceIndexes[indexIndex]]);
+	}
+	verts.swap(weldedVerts);
+}
+
+
+void OptimizeVertexCacheOrder(std::vector<unsigned int>& indexes, int numVerts)
+{
+	int numTriangles = static_cast<int>(indexes.size()) / 3;
+	if (numTriangles == 0)
+	{
+		return;
+	}
+
+	//vertex to triangle adjacency, packed into one array
+	std::vector<int> numRemainingTriangles(numVerts, 0);
+	for (int indexIndex = 0; indexIndex < numTriangles * 3; indexIndex++)
+	{
+		numRemainingTriangles[indexes[indexIndex]]++;
+	}
+
+	std::vector<int> adjacencyOffsets(numVerts + 1, 0);
+	for (int vertIndex = 0; vertIndex < numVerts; vertIndex++)
+	{
+		adjacencyOffsets[vertIndex + 1] = adjacencyOffsets[vertIndex] + numRemainingTriangles[vertIndex];
+	}
+
+	std::vector<int> adjacentTriangles(numTriangles * 3);
+	std::vector<int> adjacencyFill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+	for (int triIndex = 0; triIndex < numTriangles; triIndex++)
+	{
+		for (int cornerIndex = 0; cornerIndex < 3; cornerIndex++)
+		{
+			adjacentTriangles[adjacencyFill[indexes[triIndex * 3 + cornerIndex]]++] = triIndex;
+		}
+	}
+
+	std::vector<int> cachePositions(numVerts, -1);
+	std::vector<float> vertexScores(numVerts);
+	for (int vertIndex = 0; vertIndex < numVerts; vertIndex++)
+	{
+		vertexScores[vertIndex] = GetForsythVertexScore(-1, numRemainingTriangles[vertIndex]);
+	}
+
+	std::vector<bool> isTriangleEmitted(numTriangles, false);
+	std::vector<float> triangleScores(numTriangles);
+	for (int triIndex = 0; triIndex < numTriangles; triIndex++)
+	{
+		triangleScores[triIndex] = vertexScores[indexes[triIndex * 3]] + vertexScores[indexes[triIndex * 3 + 1]] + vertexScores[indexes[triIndex * 3 + 2]];
+	}
+
+	std::vector<unsigned int> optimizedIndexes;
+	optimizedIndexes.reserve(numTriangles * 3);
+	std::vector<int> cache;
+	cache.reserve(FORSYTH_CACHE_SIZE + 3);
+	std::vector<int> nextCache;
+	nextCache.reserve(FORSYTH_CACHE_SIZE + 3);
+
+	int bestTriangle = -1;
+	int scanCursor = 0;
+	for (int emittedCount = 0; emittedCount < numTriangles; emittedCount++)
+	{
+		//if nothing in the cache had a candidate, fall back to the best untouched triangle, scanning forwards only
+		if (bestTriangle < 0)
+		{
+			float bestScore = -1.0f;
+			for (int triIndex = scanCursor; triIndex < numTriangles; triIndex++)
+			{
+				if (!isTriangleEmitted[triIndex] && triangleScores[triIndex] > bestScore)
+				{
+					bestScore = triangleScores[triIndex];
+					bestTriangle = triIndex;
+				}
+			}
+			while (scanCursor < numTriangles && isTriangleEmitted[scanCursor])
+			{
+				scanCursor++;
+			}
+		}
+
+		isTriangleEmitted[bestTriangle] = true;
+
+		//emit, then push its vertices to the front of the cache and drop them from adjacency
+		nextCache.clear();
+		for (int cornerIndex = 0; cornerIndex < 3; cornerIndex++)
+		{
+			int vertIndex = indexes[bestTriangle * 3 + cornerIndex];
+			optimizedIndexes.emplace_back(vertIndex);
+			nextCache.emplace_back(vertIndex);
+
+			int* triangles = &adjacentTriangles[adjacencyOffsets[vertIndex]];
+			int& numRemaining = numRemainingTriangles[vertIndex];
+			for (int listIndex = 0; listIndex < numRemaining; listIndex++)
+			{
+				if (triangles[listIndex] == bestTriangle)
+				{
+					triangles[listIndex] = triangles[numRemaining - 1];
+					break;
+				}
+			}
+			numRemaining--;
+		}
+
+		for (int cacheIndex = 0; cacheIndex < cache.size(); cacheIndex++)
+		{
+			int vertIndex = cache[cacheIndex];
+			if (vertIndex != nextCache[0] && vertIndex != nextCache[1] && vertIndex != nextCache[2])
+			{
+				nextCache.emplace_back(vertIndex);
+			}
+		}
+
+		//vertices pushed out of the cache lose their cache score
+		for (int cacheIndex = FORSYTH_CACHE_SIZE; cacheIndex < nextCache.size(); cacheIndex++)
+		{
+			cachePositions[nextCache[cacheIndex]] = -1;
+			vertexScores[nextCache[cacheIndex]] = GetForsythVertexScore(-1, numRemainingTriangles[nextCache[cacheIndex]]);
+		}
+		if (nextCache.size() > FORSYTH_CACHE_SIZE)
+		{
+			nextCache.resize(FORSYTH_CACHE_SIZE);
+		}
+		cache.swap(nextCache);
+
+		//rescore everything in the cache and pick the best triangle touching it for next time
+		for (int cacheIndex = 0; cacheIndex < cache.size(); cacheIndex++)
+		{
+			int vertIndex = cache[cacheIndex];
+			cachePositions[vertIndex] = cacheIndex;
+			vertexScores[vertIndex] = GetForsythVertexScore(cacheIndex, numRemainingTriangles[vertIndex]);
+		}
+
+		bestTriangle = -1;
+		float bestScore = -1.0f;
+		for (int cacheIndex = 0; cacheIndex < cache.size(); cacheIndex++)
+		{
+			int vertIndex = cache[cacheIndex];
+			int const* triangles = &adjacentTriangles[adjacencyOffsets[vertIndex]];
+			for (int listIndex = 0; listIndex < numRemainingTriangles[vertIndex]; listIndex++)
+			{
+				int triIndex = triangles[listIndex];
+				float score = vertexScores[indexes[triIndex * 3]] + vertexScores[indexes[triIndex * 3 + 1]] + vertexScores[indexes[triIndex * 3 + 2]];
+				triangleScores[triIndex] = score;
+				if (score > bestScore)
+				{
+					bestScore = score;
+					bestTriangle = triIndex;
+				}
+			}
+		}
+	}
+
+	indexes.swap(optimizedIndexes);
+}
+
+
+void OptimizeVertexFetchOrder(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigned int>& indexes)
+{
+	std::vector<int> newIndexByVert(verts.size(), -1);
+	std::vector<Vertex_PCUTBN> orderedVerts;
+	orderedVerts.reserve(verts.size());
+
+	for (int indexIndex = 0; indexIndex < indexes.size(); indexIndex++)
+	{
+		unsigned int vertIndex = indexes[indexIndex];
+		if (newIndexByVert[vertIndex] < 0)
+		{
+			newIndexByVert[vertIndex] = static_cast<int>(orderedVerts.size());
+			orderedVerts.emplace_back(verts[vertIndex]);
+		}
+		indexes[indexIndex] = static_cast<unsigned int>(newIndexByVert[vertIndex]);
+	}
+
+	//unreferenced vertices are dropped
+	verts.swap(orderedVerts);
+}
+
+
+float GetACMR(std::vector<unsigned int> const& indexes, int numVerts, int cacheSize)
+{
+	int numTriangles = static_cast<int>(indexes.size()) / 3;
+	if (numTriangles == 0)
+	{
+		return 0.0f;
+	}
+
+	//FIFO cache as a ring buffer, with each vertex remembering when it was last pushed
+	std::vector<int> pushTimes(numVerts, -cacheSize - 1);
+	int numPushes = 0;
+	int numMisses = 0;
+	for (int indexIndex = 0; indexIndex < numTriangles * 3; indexIndex++)
+	{
+		unsigned int vertIndex = indexes[indexIndex];
+		if (numPushes - pushTimes[vertIndex] > cacheSize)
+		{
+			pushTimes[vertIndex] = numPushes;
+			numPushes++;
+			numMisses++;
+		}
+	}
+
+	return static_cast<float>(numMisses) / static_cast<float>(numTriangles);
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include "Engine/Core/Vertex_PCUTBN.hpp"
+#include <vector>
+
+
+constexpr int ACMR_FIFO_CACHE_SIZE = 16;
+
+
+//merges bitwise identical vertices, building an index buffer if the mesh didn't have one
+void WeldVertices(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigned int>& indexes);
+
+//reorders triangles so their vertices are reused while still in the post-transform cache (Forsyth's linear-speed method)
+void OptimizeVertexCacheOrder(std::vector<unsigned int>& indexes, int numVerts);
+
+//reorders vertices into the order the triangles first use them, so fetches walk memory forwards
+void OptimizeVertexFetchOrder(std::vector<Vertex_PCUTBN>& verts, std::vector<unsigned int>& indexes);
+
+//average vertex shader invocations per triangle with a FIFO post-transform cache; 3.0 is no reuse, 0.5 is the ideal for large grids
+float GetACMR(std::vector<unsigned int> const& indexes, int numVerts, int cacheSize = ACMR_FIFO_CACHE_SIZE);
@@ -0,0 +1,292 @@
+#include "Game/MeshSimplifier.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include <algorithm>
+#include <map>
+#include <tuple>
+
+
+//symmetric 4x4 error quadric, stored as its upper triangle
+struct Quadric
+{
+	double m_values[10] = {};
+
+	void AddPlane(double a, double b, double c, double d, double weight)
+	{
+		m_values[0] += weight * a * a;
+		m_values[1] += weight * a * b;
+		m_values[2] += weight * a * c;
+		m_values[3] += weight * a * d;
+		m_values[4] += weight * b * b;
+		m_values[5] += weight * b * c;
+		m_values[6] += weight * b * d;
+		m_values[7] += weight * c * c;
+		m_values[8] += weight * c * d;
+		m_values[9] += weight * d * d;
+	}
+
+	void Add(Quadric const& other)
+	{
+		for (int valueIndex = 0; valueIndex < 10; valueIndex++)
+		{
+			m_values[valueIndex] += other.m_values[valueIndex];
+		}
+	}
+
+	double GetError(Vec3 const& point) const
+	{
+		double x = point.x;
+		double y = point.y;
+		double z = point.z;
+		double const* q = m_values;
+		return q[0] * x * x + 2.0 * q[1] * x * y + 2.0 * q[2] * x * z + 2.0 * q[3] * x + q[4] * y * y + 2.0 * q[5] * y * z + 2.0 * q[6] * y + q[7] * z * z +
+			2.0 * q[8] * z + q[9];
+	}
+};
+
+
+struct EdgeCollapse
+{
+	double m_cost = 0.0;
+	int	   m_removedPos = 0;
+	int	   m_keptPos = 0;
+
+	bool operator<(EdgeCollapse const& other) const { return m_cost < other.m_cost; }
+};
+
+
+//
+//helper functions
+//
+static int ResolvePosition(std::vector<int> const& collapsedInto, int posIndex)
+{
+	while (collapsedInto[posIndex] != posIndex)
+	{
+		posIndex = collapsedInto[posIndex];
+	}
+	return posIndex;
+}
+
+
+static Vec3 GetTriangleNormal(Vec3 const& a, Vec3 const& b, Vec3 const& c)
+{
+	return CrossProduct3D(b - a, c - a);
+}
+
+
+//
+//public functions
+//
+void SimplifyMesh(std::vector<Vertex_PCUTBN> const& verts, std::vector<unsigned int> const& indexes, int targetNumTriangles,
+	std::vector<Vertex_PCUTBN>& outVerts, std::vector<unsigned int>& outIndexes)
+{
+	outVerts.clear();
+	outIndexes.clear();
+
+	int numVerts = static_cast<int>(verts.size());
+	std::vector<unsigned int> triangleIndexes = indexes;
+	if (triangleIndexes.empty())
+	{
+		for (int vertIndex = 0; vertIndex < numVerts; vertIndex++)
+		{
+			triangleIndexes.emplace_back(static_cast<unsigned int>(vertIndex));
+		}
+	}
+	int numTriangles = static_cast<int>(triangleIndexes.size()) / 3;
+
+	//weld by position so seams in normals or uvs don't stop edges from collapsing
+	std::vector<int> vertPositions(numVerts);
+	std::vector<Vec3> positions;
+	std::map<std::tuple<float, float, float>, int> positionLookup;
+	for (int vertIndex = 0; vertIndex < numVerts; vertIndex++)
+	{
+		Vec3 const& position = verts[vertIndex].m_position;
+		auto insertResult = positionLookup.insert({ std::make_tuple(position.x, position.y, position.z), static_cast<int>(positions.size()) });
+		if (insertResult.second)
+		{
+			positions.emplace_back(position);
+		}
+		vertPositions[vertIndex] = insertResult.first->second;
+	}
+	int numPositions = static_cast<int>(positions.size());
+
+	std::vector<int> collapsedInto(numPositions);
+	for (int posIndex = 0; posIndex < numPositions; posIndex++)
+	{
+		collapsedInto[posIndex] = posIndex;
+	}
+
+	//accumulate each triangle's plane into its corners' quadrics, weighted by area
+	std::vector<Quadric> quadrics(numPositions);
+	for (int triIndex = 0; triIndex < numTriangles; triIndex++)
+	{
+		int posA = vertPositions[triangleIndexes[triIndex * 3]];
+		int posB = vertPositions[triangleIndexes[triIndex * 3 + 1]];
+		int posC = vertPositions[triangleIndexes[triIndex * 3 + 2]];
+		Vec3 normal = GetTriangleNormal(positions[posA], positions[posB], positions[posC]);
+		float doubleArea = normal.GetLength();
+		if (doubleArea <= 0.0f)
+		{
+			continue;
+		}
+
+		normal = normal / doubleArea;
+		double planeDistance = -DotProduct3D(normal, positions[posA]);
+		quadrics[posA].AddPlane(normal.x, normal.y, normal.z, planeDistance, doubleArea * 0.5f);
+		quadrics[posB].AddPlane(normal.x, normal.y, normal.z, planeDistance, doubleArea * 0.5f);
+		quadrics[posC].AddPlane(normal.x, normal.y, normal.z, planeDistance, doubleArea * 0.5f);
+	}
+
+	std::vector<bool> isTriangleAlive(numTriangles, true);
+	int numAliveTriangles = numTriangles;
+
+	//collapse the cheapest edges in passes, touching each position at most once per pass so costs stay valid
+	std::vector<EdgeCollapse> collapses;
+	std::vector<std::vector<int>> trianglesByPosition(numPositions);
+	std::vector<bool> isPositionLocked(numPositions);
+	while (numAliveTriangles > targetNumTriangles)
+	{
+		collapses.clear();
+		for (int posIndex = 0; posIndex < numPositions; posIndex++)
+		{
+			trianglesByPosition[posIndex].clear();
+			isPositionLocked[posIndex] = false;
+		}
+
+		for (int triIndex = 0; triIndex < numTriangles; triIndex++)
+		{
+			if (!isTriangleAlive[triIndex])
+			{
+				continue;
+			}
+
+			for (int cornerIndex = 0; cornerIndex < 3; cornerIndex++)
+			{
+				int pos = ResolvePosition(collapsedInto, vertPositions[triangleIndexes[triIndex * 3 + cornerIndex]]);
+				int nextPos = ResolvePosition(collapsedInto, vertPositions[triangleIndexes[triIndex * 3 + (cornerIndex + 1) % 3]]);
+				trianglesByPosition[pos].emplace_back(triIndex);
+
+				//each edge is seen from both of its triangles, so only add it from the lower position's side
+				if (pos < nextPos)
+				{
+					Quadric combined = quadrics[pos];
+					combined.Add(quadrics[nextPos]);
+					double costAtPos = combined.GetError(positions[pos]);
+					double costAtNext = combined.GetError(positions[nextPos]);
+
+					EdgeCollapse collapse;
+					collapse.m_cost = std::min(costAtPos, costAtNext);
+					collapse.m_removedPos = costAtPos < costAtNext ? nextPos : pos;
+					collapse.m_keptPos = costAtPos < costAtNext ? pos : nextPos;
+					collapses.emplace_back(collapse);
+				}
+			}
+		}
+
+		std::sort(collapses.begin(), collapses.end());
+
+		int numCollapsesThisPass = 0;
+		for (int collapseIndex = 0; collapseIndex < collapses.size() && numAliveTriangles > targetNumTriangles; collapseIndex++)
+		{
+			EdgeCollapse const& collapse = collapses[collapseIndex];
+			int removedPos = collapse.m_removedPos;
+			int keptPos = collapse.m_keptPos;
+			if (isPositionLocked[removedPos] || isPositionLocked[keptPos])
+			{
+				continue;
+			}
+
+			//reject collapses that would flip a surviving triangle
+			std::vector<int> const& affectedTriangles = trianglesByPosition[removedPos];
+			bool wouldFlip = false;
+			for (int listIndex = 0; listIndex < affectedTriangles.size() && !wouldFlip; listIndex++)
+			{
+				int triIndex = affectedTriangles[listIndex];
+				if (!isTriangleAlive[triIndex])
+				{
+					continue;
+				}
+
+				int cornerPositions[3];
+				bool containsKept = false;
+				for (int cornerIndex = 0; cornerIndex < 3; cornerIndex++)
+				{
+					cornerPositions[cornerIndex] = ResolvePosition(collapsedInto, vertPositions[triangleIndexes[triIndex * 3 + cornerIndex]]);
+					containsKept = containsKept || cornerPositions[cornerIndex] == keptPos;
+				}
+				if (containsKept)
+				{
+					continue;
+				}
+
+				Vec3 oldNormal = GetTriangleNormal(positions[cornerPositions[0]], positions[cornerPositions[1]], positions[cornerPositions[2]]);
+				for (int cornerIndex = 0; cornerIndex < 3; cornerIndex++)
+				{
+					if (cornerPositions[cornerIndex] == removedPos)
+					{
+						cornerPositions[cornerIndex] = keptPos;
+					}
+				}
+				Vec3 newNormal = GetTriangleNormal(positions[cornerPositions[0]], positions[cornerPositions[1]], positions[cornerPositions[2]]);
+				wouldFlip = DotProduct3D(oldNormal, newNormal) <= 0.0f;
+			}
+
+			if (wouldFlip)
+			{
+				continue;
+			}
+
+			collapsedInto[removedPos] = keptPos;
+			quadrics[keptPos].Add(quadrics[removedPos]);
+			isPositionLocked[removedPos] = true;
+			isPositionLocked[keptPos] = true;
+			numCollapsesThisPass++;
+
+			//triangles along the collapsed edge become degenerate
+			for (int listIndex = 0; listIndex < affectedTriangles.size(); listIndex++)
+			{
+				int triIndex = affectedTriangles[listIndex];
+				if (!isTriangleAlive[triIndex])
+				{
+					continue;
+				}
+
+				int posA = ResolvePosition(collapsedInto, vertPositions[triangleIndexes[triIndex * 3]]);
+				int posB = ResolvePosition(collapsedInto, vertPositions[triangleIndexes[triIndex * 3 + 1]]);
+				int posC = ResolvePosition(collapsedInto, vertPositions[triangleIndexes[triIndex * 3 + 2]]);
+				if (posA == posB || posB == posC || posC == posA)
+				{
+					isTriangleAlive[triIndex] = false;
+					numAliveTriangles--;
+				}
+			}
+		}
+
+		if (numCollapsesThisPass == 0)
+		{
+			break;
+		}
+	}
+
+	//emit the surviving triangles, keeping each original vertex's attributes at its collapsed position
+	std::vector<int> outVertIndexes(numVerts, -1);
+	for (int triIndex = 0; triIndex < numTriangles; triIndex++)
+	{
+		if (!isTriangleAlive[triIndex])
+		{
+			continue;
+		}
+
+		for (int cornerIndex = 0; cornerIndex < 3; cornerIndex++)
+		{
+			int vertIndex = triangleIndexes[triIndex * 3 + cornerIndex];
+			if (outVertIndexes[vertIndex] < 0)
+			{
+				outVertIndexes[vertIndex] = static_cast<int>(outVerts.size());
+				Vertex_PCUTBN vert = verts[vertIndex];
+				vert.m_position = positions[ResolvePosition(collapsedInto, vertPositions[vertIndex])];
+				outVerts.emplace_back(vert);
+			}
+			outIndexes.emplace_back(static_cast<unsigned int>(outVertIndexes[vertIndex]));
+		}
+	}
+}
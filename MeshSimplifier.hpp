@@ -0,0 +1,9 @@
+#pragma once
+#include "Engine/Core/Vertex_PCUTBN.hpp"
+#include <vector>
+
+
+//reduces a mesh to roughly the target triangle count with quadric error edge collapses, welding split vertices by position first
+//indexes may be empty for unindexed meshes; the output is always indexed
+void SimplifyMesh(std::vector<Vertex_PCUTBN> const& verts, std::vector<unsigned int> const& indexes, int targetNumTriangles,
+	std::vector<Vertex_PCUTBN>& outVerts, std::vector<unsigned int>& outIndexes);
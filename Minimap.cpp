@@ -0,0 +1,173 @@
+#include "Game/Minimap.hpp"
+#include "Game/Map.hpp"
+#include "Game/Game.hpp"
+#include "Game/GameCommon.hpp"
+#include "Game/RenderQueue.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/VertexBuffer.hpp"
+#include "Engine/Renderer/IndexBuffer.hpp"
+
+
+constexpr int MINIMAP_VERTS_PER_TEXEL = 4;
+constexpr int MINIMAP_INDEXES_PER_TEXEL = 6;
+
+
+//
+//constructor and destructor
+//
+Minimap::Minimap(Map const* map, AABB2 const& maxScreenBounds)
+	: m_map(map)
+{
+	//fit the map's world bounds into the screen bounds without stretching, anchored to the top right
+	Vec3 worldMins = map->m_definition->m_boundsMin;
+	Vec3 worldMaxs = map->m_definition->m_boundsMax;
+	float worldWidth = worldMaxs.x - worldMins.x;
+	float worldHeight = worldMaxs.y - worldMins.y;
+	float maxWidth = maxScreenBounds.m_maxs.x - maxScreenBounds.m_mins.x;
+	float maxHeight = maxScreenBounds.m_maxs.y - maxScreenBounds.m_mins.y;
+	float worldToScreen = std::min(maxWidth / worldWidth, maxHeight / worldHeight);
+	m_screenBounds = AABB2(maxScreenBounds.m_maxs.x - worldWidth * worldToScreen, maxScreenBounds.m_maxs.y - worldHeight * worldToScreen, maxScreenBounds.m_maxs.x,
+		maxScreenBounds.m_maxs.y);
+
+	//background quad
+	int numTiles = static_cast<int>(map->m_tiles.size());
+	m_verts.reserve((numTiles + 1) * MINIMAP_VERTS_PER_TEXEL);
+	m_indexes.reserve((numTiles + 1) * MINIMAP_INDEXES_PER_TEXEL);
+	AABB2 backgroundBounds = AABB2(m_screenBounds.m_mins.x - 4.0f, m_screenBounds.m_mins.y - 4.0f, m_screenBounds.m_maxs.x, m_screenBounds.m_maxs.y);
+	m_verts.emplace_back(Vertex_PCU(Vec3(backgroundBounds.m_mins.x, backgroundBounds.m_mins.y, 0.0f), MINIMAP_BACKGROUND_COLOR));
+	m_verts.emplace_back(Vertex_PCU(Vec3(backgroundBounds.m_maxs.x, backgroundBounds.m_mins.y, 0.0f), MINIMAP_BACKGROUND_COLOR));
+	m_verts.emplace_back(Vertex_PCU(Vec3(backgroundBounds.m_maxs.x, backgroundBounds.m_maxs.y, 0.0f), MINIMAP_BACKGROUND_COLOR));
+	m_verts.emplace_back(Vertex_PCU(Vec3(backgroundBounds.m_mins.x, backgroundBounds.m_maxs.y, 0.0f), MINIMAP_BACKGROUND_COLOR));
+
+	//one texel per tile, placed where the tile's center lands in the hex layout
+	float texelHalfWidth = INRADIUS * 0.866f * worldToScreen;
+	float texelHalfHeight = INRADIUS * worldToScreen;
+	for (int tileIndex = 0; tileIndex < numTiles; tileIndex++)
+	{
+		Tile const& tile = map->m_tiles[tileIndex];
+		float centerX = m_screenBounds.m_mins.x + (tile.GetCenterPosX() - worldMins.x) * worldToScreen;
+		float centerY = m_screenBounds.m_mins.y + (tile.GetCenterPosY() - worldMins.y) * worldToScreen;
+		Rgba8 color = GetTexelColor(tile);
+
+		m_verts.emplace_back(Vertex_PCU(Vec3(centerX - texelHalfWidth, centerY - texelHalfHeight, 0.0f), color));
+		m_verts.emplace_back(Vertex_PCU(Vec3(centerX + texelHalfWidth, centerY - texelHalfHeight, 0.0f), color));
+		m_verts.emplace_back(Vertex_PCU(Vec3(centerX + texelHalfWidth, centerY + texelHalfHeight, 0.0f), color));
+		m_verts.emplace_back(Vertex_PCU(Vec3(centerX - texelHalfWidth, centerY + texelHalfHeight, 0.0f), color));
+	}
+
+	for (int texelIndex = 0; texelIndex <= numTiles; texelIndex++)
+	{
+		unsigned int firstVert = texelIndex * MINIMAP_VERTS_PER_TEXEL;
+		m_indexes.emplace_back(firstVert);
+		m_indexes.emplace_back(firstVert + 1);
+		m_indexes.emplace_back(firstVert + 2);
+		m_indexes.emplace_back(firstVert);
+		m_indexes.emplace_back(firstVert + 2);
+		m_indexes.emplace_back(firstVert + 3);
+	}
+
+	m_isTileDirty.resize(numTiles, false);
+
+	if (g_theRenderer == nullptr)
+	{
+		return;
+	}
+
+	m_vertexBuffer = g_theRenderer->CreateVertexBuffer(sizeof(Vertex_PCU), sizeof(Vertex_PCU));
+	m_indexBuffer = g_theRenderer->CreateIndexBuffer(sizeof(unsigned int));
+	g_theRenderer->CopyCPUToGPU(m_verts.data(), static_cast<int>(m_verts.size()) * sizeof(Vertex_PCU), m_vertexBuffer);
+	g_theRenderer->CopyCPUToGPU(m_indexes.data(), static_cast<int>(m_indexes.size()) * sizeof(unsigned int), m_indexBuffer);
+}
+
+
+Minimap::~Minimap()
+{
+	if (m_vertexBuffer != nullptr)
+	{
+		delete m_vertexBuffer;
+		m_vertexBuffer = nullptr;
+	}
+
+	if (m_indexBuffer != nullptr)
+	{
+		delete m_indexBuffer;
+		m_indexBuffer = nullptr;
+	}
+}
+
+
+//
+//minimap functions
+//
+void Minimap::MarkTileDirty(IntVec2 const& tileCoords)
+{
+	int tileIndex = m_map->GetTileIndex(tileCoords);
+	if (tileIndex < 0 || tileIndex >= m_isTileDirty.size() || m_isTileDirty[tileIndex])
+	{
+		return;
+	}
+
+	m_isTileDirty[tileIndex] = true;
+	m_dirtyTileIndexes.emplace_back(tileIndex);
+}
+
+
+void Minimap::Render()
+{
+	UpdateDirtyTexels();
+
+	g_theGame->m_renderQueue->SubmitIndexedBuffer(RenderPass::UI_PANELS, nullptr, nullptr, DepthMode::ENABLED, m_vertexBuffer, m_indexBuffer, static_cast<int>(m_indexes.size()));
+}
+
+
+//
+//private minimap functions
+//
+Rgba8 Minimap::GetTexelColor(Tile const& tile) const
+{
+	if (!m_map->IsTileInBounds(tile))
+	{
+		return MINIMAP_EMPTY_COLOR;
+	}
+
+	Unit const* unit = m_map->GetUnitAtCoords(tile.m_coords, 0);
+	if (unit != nullptr)
+	{
+		return unit->m_ownerID == 1 ? MINIMAP_PLAYER_1_COLOR : MINIMAP_PLAYER_2_COLOR;
+	}
+
+	return tile.m_definition->m_isBlocked ? MINIMAP_BLOCKED_TILE_COLOR : MINIMAP_TILE_COLOR;
+}
+
+
+void Minimap::SetTexelColor(int tileIndex, Rgba8 const& color)
+{
+	int firstVert = (tileIndex + 1) * MINIMAP_VERTS_PER_TEXEL;
+	for (int vertIndex = firstVert; vertIndex < firstVert + MINIMAP_VERTS_PER_TEXEL; vertIndex++)
+	{
+		m_verts[vertIndex].m_color = color;
+	}
+}
+
+
+void Minimap::UpdateDirtyTexels()
+{
+	if (m_dirtyTileIndexes.empty())
+	{
+		return;
+	}
+
+	//only the texels for tiles that changed get recolored
+	for (int dirtyIndex = 0; dirtyIndex < m_dirtyTileIndexes.size(); dirtyIndex++)
+	{
+		int tileIndex = m_dirtyTileIndexes[dirtyIndex];
+		SetTexelColor(tileIndex, GetTexelColor(m_map->m_tiles[tileIndex]));
+		m_isTileDirty[tileIndex] = false;
+	}
+	m_dirtyTileIndexes.clear();
+
+	if (m_vertexBuffer != nullptr)
+	{
+		g_theRenderer->CopyCPUToGPU(m_verts.data(), static_cast<int>(m_verts.size()) * sizeof(Vertex_PCU), m_vertexBuffer);
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/IntVec2.hpp"
+
+
+//forward declarations
+class Map;
+class Tile;
+class VertexBuffer;
+class IndexBuffer;
+
+
+static Rgba8 const MINIMAP_BACKGROUND_COLOR = Rgba8(0, 0, 0, 180);
+static Rgba8 const MINIMAP_TILE_COLOR = Rgba8(110, 110, 110);
+static Rgba8 const MINIMAP_BLOCKED_TILE_COLOR = Rgba8(30, 30, 30);
+static Rgba8 const MINIMAP_EMPTY_COLOR = Rgba8(0, 0, 0, 0);
+static Rgba8 const MINIMAP_PLAYER_1_COLOR = Rgba8(150, 150, 255);
+static Rgba8 const MINIMAP_PLAYER_2_COLOR = Rgba8(255, 150, 150);
+
+
+class Minimap
+{
+//public member functions
+public:
+	//constructor and destructor
+	Minimap(Map const* map, AABB2 const& maxScreenBounds);
+	Minimap(Minimap const& copy) = delete;
+	~Minimap();
+
+	//minimap functions
+	void MarkTileDirty(IntVec2 const& tileCoords);
+	void Render();
+
+//public member variables
+public:
+	Map const* m_map = nullptr;
+	AABB2	   m_screenBounds;
+
+	//one texel quad per tile, after a single background quad
+	std::vector<Vertex_PCU>	  m_verts;
+	std::vector<unsigned int> m_indexes;
+	VertexBuffer*			  m_vertexBuffer = nullptr;
+	IndexBuffer*			  m_indexBuffer = nullptr;
+
+	std::vector<int>  m_dirtyTileIndexes;
+	std::vector<bool> m_isTileDirty;
+
+//private member functions
+private:
+	Rgba8 GetTexelColor(Tile const& tile) const;
+	void  SetTexelColor(int tileIndex, Rgba8 const& color);
+	void  UpdateDirtyTexels();
+};
@@ -1,105 +1,376 @@
-#include "Game/GameCommon.hpp"
-#include "Game/Model.hpp"
-#include "Engine/Renderer/CPUMesh.hpp"
-#include "Engine/Renderer/GPUMesh.hpp"
-#include "Engine/Renderer/Shader.hpp"
-#include "Engine/Core/OBJLoader.hpp"
-#include "Engine/Renderer/Renderer.hpp"
-#include "Engine/Renderer/DebugRenderSystem.hpp"
-#include "Engine/Core/XmlUtils.hpp"
-
-
-//
-//constructor and destructor
-//
-Model::Model()
-{
-	m_cpuMesh = new CPUMesh();
-	m_gpuMesh = new GPUMesh();
-}
-
-Model::~Model()
-{
-	if (m_cpuMesh != nullptr)
-	{
-		delete m_cpuMesh;
-	}
-	if (m_gpuMesh != nullptr)
-	{
-		delete m_gpuMesh;
-	}
-}
-
-//
-//model creation and rendering
-//
-bool Model::ParseXMLFileForOBJ(std::string const& fileName)
-{
-	//parse xml for obj file name and fixup matrix
-	XmlDocument modelXml;
-	XmlError result = modelXml.LoadFile(fileName.c_str());
-	if (result != tinyxml2::XML_SUCCESS)
-	{
-		ERROR_RECOVERABLE("Failed to open model xml file!");
-		return false;
-	}
-	XmlElement* rootElement = modelXml.RootElement();
-	if (rootElement == nullptr)
-	{
-		ERROR_RECOVERABLE("Failed to read model xml root element!");
-		return false;
-	}
-	
-	std::string const& objFilePath = ParseXmlAttribute(*rootElement, "path", "invalid path");
-	std::string const& shaderName = ParseXmlAttribute(*rootElement, "shader", "invalid shader path");
-	if (shaderName == "invalid shader path")
-	{
-		ERROR_RECOVERABLE("Couldn't find shader in xml!");
-		return false;
-	}
-	m_shader = g_theRenderer->CreateShader(shaderName.c_str());
-
-	XmlElement* transformElement = rootElement->FirstChildElement();
-	Mat44 matrix = Mat44();
-	Vec3 iBasis = ParseXmlAttribute(*transformElement, "x", Vec3());
-	Vec3 jBasis = ParseXmlAttribute(*transformElement, "y", Vec3());
-	Vec3 kBasis = ParseXmlAttribute(*transformElement, "z", Vec3());
-	Vec3 translation = ParseXmlAttribute(*transformElement, "t", Vec3());
-	matrix.SetIJKT3D(iBasis, jBasis, kBasis, translation);
-	matrix.AppendScaleUniform3D(ParseXmlAttribute(*transformElement, "scale", 1.0f));
-
-	//pass into obj loader along with vertex and index vectors from cpu mesh
-	OBJLoader::LoadObjFile(objFilePath, matrix, m_cpuMesh->m_vertexes, m_cpuMesh->m_indexes);
-
-	m_gpuMesh->m_vertexBuffer = g_theRenderer->CreateVertexBuffer(sizeof(Vertex_PCUTBN), sizeof(Vertex_PCUTBN));
-	g_theRenderer->CopyCPUToGPU(m_cpuMesh->m_vertexes.data(), static_cast<int>(m_cpuMesh->m_vertexes.size()) * sizeof(Vertex_PCUTBN), m_gpuMesh->m_vertexBuffer);
-
-	if (m_cpuMesh->m_indexes.size() > 0)
-	{
-		m_gpuMesh->m_indexBuffer = g_theRenderer->CreateIndexBuffer(sizeof(int));
-		g_theRenderer->CopyCPUToGPU(m_cpuMesh->m_indexes.data(), static_cast<int>(m_cpuMesh->m_indexes.size()) * sizeof(int), m_gpuMesh->m_indexBuffer);
-	}
-
-	return true;
-}
-
-
-void Model::RenderGPUMesh(Vec3 sunDirection, float sunIntensity, float ambientIntensity, Vec3 position, EulerAngles orientation, Rgba8 color) const
-{
-	Mat44 modelMatrix = orientation.GetAsMatrix_XFwd_YLeft_ZUp();
-	modelMatrix.AppendTranslation3D(position);
-	
-	g_theRenderer->BindShader(m_shader);
-	g_theRenderer->BindTexture(nullptr);
-	g_theRenderer->SetModelConstants(modelMatrix, color);
-	g_theRenderer->SetLightConstants(sunDirection, sunIntensity, ambientIntensity);
-
-	if (m_cpuMesh->m_indexes.size() > 0)
-	{
-		g_theRenderer->DrawVertexBufferIndexed(m_gpuMesh->m_vertexBuffer, m_gpuMesh->m_indexBuffer, static_cast<int>(m_cpuMesh->m_indexes.size()));
-	}
-	else
-	{
-		g_theRenderer->DrawVertexBuffer(m_gpuMesh->m_vertexBuffer, static_cast<int>(m_cpuMesh->m_vertexes.size()));
-	}
-}
+#include "Game/GameCommon.hpp"
+#include "Game/Model.hpp"
+#include "Game/RenderQueue.hpp"
+#include "Game/SoftwareRenderer.hpp"
+#include "Game/MeshSimplifier.hpp"
+#include "Game/MeshOptimizer.hpp"
+#include "Engine/Renderer/CPUMesh.hpp"
+#include "Engine/Renderer/Shader.hpp"
+#include "Engine/Renderer/VertexBuffer.hpp"
+#include "Engine/Renderer/IndexBuffer.hpp"
+#include "Engine/Core/OBJLoader.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/DebugRenderSystem.hpp"
+#include "Engine/Core/XmlUtils.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/StringUtils.hpp"
+
+
+//
+//model instance comparison
+//
+bool ModelInstance::operator==(ModelInstance const& other) const
+{
+	return m_position == other.m_position && m_color == other.m_color && m_orientation.m_yawDegrees == other.m_orientation.m_yawDegrees &&
+		m_orientation.m_pitchDegrees == other.m_orientation.m_pitchDegrees && m_orientation.m_rollDegrees == other.m_orientation.m_rollDegrees;
+}
+
+
+bool ModelInstance::operator!=(ModelInstance const& other) const
+{
+	return !(*this == other);
+}
+
+
+//
+//constructor and destructor
+//
+Model::Model()
+{
+	m_cpuMesh = new CPUMesh();
+}
+
+Model::~Model()
+{
+	if (m_cpuMesh != nullptr)
+	{
+		delete m_cpuMesh;
+	}
+	for (int lodIndex = 0; lodIndex < MODEL_NUM_LODS; lodIndex++)
+	{
+		if (m_lods[lodIndex].m_batchVertexBuffer != nullptr)
+		{
+			delete m_lods[lodIndex].m_batchVertexBuffer;
+		}
+		if (m_lods[lodIndex].m_batchIndexBuffer != nullptr)
+		{
+			delete m_lods[lodIndex].m_batchIndexBuffer;
+		}
+	}
+}
+
+//
+//model creation and rendering
+//
+bool Model::ParseXMLFileForOBJ(std::string const& fileName)
+{
+	//parse xml for obj file name and fixup matrix
+	XmlDocument modelXml;
+	XmlError result = modelXml.LoadFile(fileName.c_str());
+	if (result != tinyxml2::XML_SUCCESS)
+	{
+		ERROR_RECOVERABLE("Failed to open model xml file!");
+		return false;
+	}
+	XmlElement* rootElement = modelXml.RootElement();
+	if (rootElement == nullptr)
+	{
+		ERROR_RECOVERABLE("Failed to read model xml root element!");
+		return false;
+	}
+	
+	std::string const& objFilePath = ParseXmlAttribute(*rootElement, "path", "invalid path");
+	std::string const& shaderName = ParseXmlAttribute(*rootElement, "shader", "invalid shader path");
+	if (shaderName == "invalid shader path")
+	{
+		ERROR_RECOVERABLE("Couldn't find shader in xml!");
+		return false;
+	}
+	if (g_theRenderer != nullptr)
+	{
+		m_shader = g_theRenderer->CreateShader(shaderName.c_str());
+	}
+
+	XmlElement* transformElement = rootElement->FirstChildElement();
+	Mat44 matrix = Mat44();
+	Vec3 iBasis = ParseXmlAttribute(*transformElement, "x", Vec3());
+	Vec3 jBasis = ParseXmlAttribute(*transformElement, "y", Vec3());
+	Vec3 kBasis = ParseXmlAttribute(*transformElement, "z", Vec3());
+	Vec3 translation = ParseXmlAttribute(*transformElement, "t", Vec3());
+	matrix.SetIJKT3D(iBasis, jBasis, kBasis, translation);
+	matrix.AppendScaleUniform3D(ParseXmlAttribute(*transformElement, "scale", 1.0f));
+
+	//pass into obj loader along with vertex and index vectors from cpu mesh
+	OBJLoader::LoadObjFile(objFilePath, matrix, m_cpuMesh->m_vertexes, m_cpuMesh->m_indexes);
+
+	//weld duplicate vertices into an index buffer, then order triangles for the post-transform cache and vertices for fetch locality
+	std::vector<Vertex_PCUTBN>& meshVerts = m_cpuMesh->m_vertexes;
+	std::vector<unsigned int>& meshIndexes = m_cpuMesh->m_indexes;
+	float loadedACMR = meshIndexes.empty() ? 3.0f : GetACMR(meshIndexes, static_cast<int>(meshVerts.size()));
+	int numLoadedVerts = static_cast<int>(meshVerts.size());
+	WeldVertices(meshVerts, meshIndexes);
+	OptimizeVertexCacheOrder(meshIndexes, static_cast<int>(meshVerts.size()));
+	OptimizeVertexFetchOrder(meshVerts, meshIndexes);
+	m_acmr = GetACMR(meshIndexes, static_cast<int>(meshVerts.size()));
+
+	std::string optimizeMessage = Stringf("%s: %i verts welded to %i, %i triangles, ACMR %.2f -> %.2f", objFilePath.c_str(), numLoadedVerts, static_cast<int>(meshVerts.size()),
+		static_cast<int>(meshIndexes.size()) / 3, loadedACMR, m_acmr);
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, optimizeMessage);
+
+	//get bounding sphere radius around the model origin for culling
+	m_boundingRadius = 0.0f;
+	for (int vertIndex = 0; vertIndex < m_cpuMesh->m_vertexes.size(); vertIndex++)
+	{
+		m_boundingRadius = std::max(m_boundingRadius, m_cpuMesh->m_vertexes[vertIndex].m_position.GetLength());
+	}
+
+	GenerateLODs();
+
+	//the quantized LODs are the only CPU copy kept after load
+	//the GPU batches are still floats, with every instance baked in at every LOD plus indexes for at most its full detail mesh
+	size_t floatBytes = m_cpuMesh->m_vertexes.size() * sizeof(Vertex_PCUTBN) + m_cpuMesh->m_indexes.size() * sizeof(unsigned int);
+	size_t quantizedBytes = 0;
+	size_t gpuBytesPerInstance = m_cpuMesh->m_indexes.size() * sizeof(unsigned int);
+	for (int lodIndex = 0; lodIndex < MODEL_NUM_LODS; lodIndex++)
+	{
+		quantizedBytes += m_lods[lodIndex].m_mesh.GetMemoryBytes();
+		gpuBytesPerInstance += m_lods[lodIndex].m_mesh.GetNumVerts() * sizeof(Vertex_PCUTBN);
+	}
+	m_cpuMesh->m_vertexes = std::vector<Vertex_PCUTBN>();
+	m_cpuMesh->m_indexes = std::vector<unsigned int>();
+
+	std::string memoryMessage = Stringf("%s: %i KB for all LODs quantized, %i KB for LOD 0 as floats, up to %i KB per instance in the GPU batches", objFilePath.c_str(),
+		static_cast<int>(quantizedBytes / 1024), static_cast<int>(floatBytes / 1024), static_cast<int>(gpuBytesPerInstance / 1024));
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, memoryMessage);
+
+	return true;
+}
+
+
+void Model::SubmitInstances(RenderQueue& renderQueue, std::vector<ModelInstance> const& instances, std::vector<int> const& instanceLODs) const
+{
+	if (instances.empty())
+	{
+		return;
+	}
+
+	//the baked verts hold every instance at every LOD, so they only need to be rebuilt and re-uploaded when a unit moves, changes color, or dies,
+	//never because the camera moved
+	bool areBatchesRebuilt = instances != m_batchInstances;
+	if (areBatchesRebuilt)
+	{
+		RebuildInstanceBatches(instances);
+	}
+
+	//culling and LOD selection only repack the indexes, and only when they've changed
+	if (areBatchesRebuilt || instanceLODs != m_batchInstanceLODs)
+	{
+		RebuildDrawnIndexes(instanceLODs);
+	}
+
+	//one draw per level of detail, however the instances drawn at it are scattered through the list
+	//lighting is set once per frame by whoever is drawing the instances
+	for (int lodIndex = 0; lodIndex < MODEL_NUM_LODS; lodIndex++)
+	{
+		ModelLOD const& lod = m_lods[lodIndex];
+		if (lod.m_numBatchIndexes > 0)
+		{
+			renderQueue.SubmitIndexedBuffer(RenderPass::UNITS, m_shader, nullptr, DepthMode::ENABLED, lod.m_batchVertexBuffer, lod.m_batchIndexBuffer, lod.m_numBatchIndexes);
+		}
+	}
+}
+
+
+void Model::RenderSoftware(SoftwareRenderer& renderer, std::vector<ModelInstance> const& instances) const
+{
+	//thumbnails always use full detail
+	std::vector<Vertex_PCUTBN> meshVerts;
+	m_lods[0].m_mesh.DecodeVerts(meshVerts);
+	std::vector<unsigned int> const& meshIndexes = m_lods[0].m_mesh.m_indexes;
+
+	//transform into a scratch copy so the GPU instance batch is left alone
+	std::vector<Vertex_PCUTBN> instanceVerts;
+	instanceVerts.resize(meshVerts.size());
+	for (int instanceIndex = 0; instanceIndex < instances.size(); instanceIndex++)
+	{
+		ModelInstance const& instance = instances[instanceIndex];
+		Mat44 modelMatrix = instance.m_orientation.GetAsMatrix_XFwd_YLeft_ZUp();
+		modelMatrix.AppendTranslation3D(instance.m_position);
+
+		for (int vertIndex = 0; vertIndex < meshVerts.size(); vertIndex++)
+		{
+			Vertex_PCUTBN& vert = instanceVerts[vertIndex];
+			vert = meshVerts[vertIndex];
+			vert.m_position = modelMatrix.TransformPosition3D(vert.m_position);
+			vert.m_normal = modelMatrix.TransformVectorQuantity3D(vert.m_normal);
+			vert.m_color.r = static_cast<unsigned char>((vert.m_color.r * instance.m_color.r) / 255);
+			vert.m_color.g = static_cast<unsigned char>((vert.m_color.g * instance.m_color.g) / 255);
+			vert.m_color.b = static_cast<unsigned char>((vert.m_color.b * instance.m_color.b) / 255);
+			vert.m_color.a = static_cast<unsigned char>((vert.m_color.a * instance.m_color.a) / 255);
+		}
+
+		renderer.DrawIndexedLit(instanceVerts.data(), meshIndexes.data(), static_cast<int>(meshIndexes.size()), DepthMode::ENABLED);
+	}
+}
+
+
+//
+//accessors
+//
+size_t Model::GetBatchGPUBytes() const
+{
+	size_t numBytes = 0;
+	for (int lodIndex = 0; lodIndex < MODEL_NUM_LODS; lodIndex++)
+	{
+		numBytes += m_lods[lodIndex].m_numBatchVerts * sizeof(Vertex_PCUTBN) + m_lods[lodIndex].m_numBatchIndexes * sizeof(unsigned int);
+	}
+	return numBytes;
+}
+
+
+//
+//public static model functions
+//
+int Model::GetLODIndexForScreenFraction(float screenFraction, int currentLODIndex)
+{
+	//thresholds above the current level are raised and the rest lowered, and an instance with no current level uses them as they are
+	for (int lodIndex = 0; lodIndex < MODEL_NUM_LODS - 1; lodIndex++)
+	{
+		float thresholdFactor = 1.0f;
+		if (currentLODIndex >= 0)
+		{
+			thresholdFactor = lodIndex < currentLODIndex ? MODEL_LOD_SWITCH_TO_HIGHER_FACTOR : MODEL_LOD_SWITCH_TO_LOWER_FACTOR;
+		}
+
+		if (screenFraction >= MODEL_LOD_MIN_SCREEN_FRACTIONS[lodIndex] * thresholdFactor)
+		{
+			return lodIndex;
+		}
+	}
+
+	return MODEL_NUM_LODS - 1;
+}
+
+
+//
+//private model functions
+//
+void Model::GenerateLODs()
+{
+	//full detail keeps the mesh as loaded, lower levels are simplified from it
+	m_lods[0].m_mesh.Encode(m_cpuMesh->m_vertexes, m_cpuMesh->m_indexes);
+
+	std::vector<Vertex_PCUTBN> lodVerts;
+	std::vector<unsigned int> lodIndexes;
+	int numTriangles = static_cast<int>(m_cpuMesh->m_indexes.size()) / 3;
+	for (int lodIndex = 1; lodIndex < MODEL_NUM_LODS; lodIndex++)
+	{
+		int targetNumTriangles = static_cast<int>(numTriangles * MODEL_LOD_TRIANGLE_FRACTIONS[lodIndex]);
+		SimplifyMesh(m_cpuMesh->m_vertexes, m_cpuMesh->m_indexes, targetNumTriangles, lodVerts, lodIndexes);
+		OptimizeVertexCacheOrder(lodIndexes, static_cast<int>(lodVerts.size()));
+		OptimizeVertexFetchOrder(lodVerts, lodIndexes);
+		m_lods[lodIndex].m_mesh.Encode(lodVerts, lodIndexes);
+	}
+}
+
+
+void Model::RebuildInstanceBatches(std::vector<ModelInstance> const& instances) const
+{
+	m_batchInstances = instances;
+
+	//every level decodes and bakes into the same scratch, which is sized by full detail first and then reused by the smaller levels
+	std::vector<Vertex_PCUTBN> meshVerts;
+	std::vector<Vertex_PCUTBN> batchVerts;
+	for (int lodIndex = 0; lodIndex < MODEL_NUM_LODS; lodIndex++)
+	{
+		RebuildInstanceBatch(m_lods[lodIndex], instances, meshVerts, batchVerts);
+	}
+}
+
+
+void Model::RebuildInstanceBatch(ModelLOD const& lod, std::vector<ModelInstance> const& instances, std::vector<Vertex_PCUTBN>& meshVerts, std::vector<Vertex_PCUTBN>& batchVerts) const
+{
+	lod.m_mesh.DecodeVerts(meshVerts);
+	int numMeshVerts = static_cast<int>(meshVerts.size());
+
+	batchVerts.clear();
+	batchVerts.reserve(meshVerts.size() * instances.size());
+
+	//bake each instance's transform and color into its own copy of the mesh
+	for (int instanceIndex = 0; instanceIndex < instances.size(); instanceIndex++)
+	{
+		ModelInstance const& instance = instances[instanceIndex];
+		Mat44 modelMatrix = instance.m_orientation.GetAsMatrix_XFwd_YLeft_ZUp();
+		modelMatrix.AppendTranslation3D(instance.m_position);
+
+		for (int vertIndex = 0; vertIndex < numMeshVerts; vertIndex++)
+		{
+			Vertex_PCUTBN vert = meshVerts[vertIndex];
+			vert.m_position = modelMatrix.TransformPosition3D(vert.m_position);
+			vert.m_normal = modelMatrix.TransformVectorQuantity3D(vert.m_normal);
+			vert.m_tangent = modelMatrix.TransformVectorQuantity3D(vert.m_tangent);
+			vert.m_bitangent = modelMatrix.TransformVectorQuantity3D(vert.m_bitangent);
+			vert.m_color.r = static_cast<unsigned char>((vert.m_color.r * instance.m_color.r) / 255);
+			vert.m_color.g = static_cast<unsigned char>((vert.m_color.g * instance.m_color.g) / 255);
+			vert.m_color.b = static_cast<unsigned char>((vert.m_color.b * instance.m_color.b) / 255);
+			vert.m_color.a = static_cast<unsigned char>((vert.m_color.a * instance.m_color.a) / 255);
+			batchVerts.emplace_back(vert);
+		}
+	}
+
+	if (lod.m_batchVertexBuffer == nullptr)
+	{
+		lod.m_batchVertexBuffer = g_theRenderer->CreateVertexBuffer(sizeof(Vertex_PCUTBN), sizeof(Vertex_PCUTBN));
+		lod.m_batchIndexBuffer = g_theRenderer->CreateIndexBuffer(sizeof(unsigned int));
+	}
+
+	lod.m_numBatchVerts = static_cast<int>(batchVerts.size());
+	g_theRenderer->CopyCPUToGPU(batchVerts.data(), static_cast<int>(batchVerts.size()) * sizeof(Vertex_PCUTBN), lod.m_batchVertexBuffer);
+}
+
+
+void Model::RebuildDrawnIndexes(std::vector<int> const& instanceLODs) const
+{
+	m_batchInstanceLODs = instanceLODs;
+
+	//each level packs the mesh's indexes for just the instances drawn at it, offset into their range of the baked verts
+	//an LOD of -1 means the instance was culled, so it's in no level's indexes
+	std::vector<unsigned int> drawnIndexes;
+	for (int lodIndex = 0; lodIndex < MODEL_NUM_LODS; lodIndex++)
+	{
+		ModelLOD const& lod = m_lods[lodIndex];
+		std::vector<unsigned int> const& meshIndexes = lod.m_mesh.m_indexes;
+		unsigned int numMeshVerts = static_cast<unsigned int>(lod.m_mesh.GetNumVerts());
+
+		drawnIndexes.clear();
+		for (int instanceIndex = 0; instanceIndex < instanceLODs.size(); instanceIndex++)
+		{
+			if (instanceLODs[instanceIndex] != lodIndex)
+			{
+				continue;
+			}
+
+			unsigned int baseVertex = static_cast<unsigned int>(instanceIndex) * numMeshVerts;
+			if (meshIndexes.empty())
+			{
+				for (unsigned int vertIndex = 0; vertIndex < numMeshVerts; vertIndex++)
+				{
+					drawnIndexes.emplace_back(baseVertex + vertIndex);
+				}
+			}
+			else
+			{
+				for (int indexIndex = 0; indexIndex < meshIndexes.size(); indexIndex++)
+				{
+					drawnIndexes.emplace_back(baseVertex + meshIndexes[indexIndex]);
+				}
+			}
+		}
+
+		lod.m_numBatchIndexes = static_cast<int>(drawnIndexes.size());
+		if (!drawnIndexes.empty())
+		{
+			g_theRenderer->CopyCPUToGPU(drawnIndexes.data(), static_cast<int>(drawnIndexes.size()) * sizeof(unsigned int), lod.m_batchIndexBuffer);
+		}
+	}
+}
@@ -1,30 +1,94 @@
-#pragma once
-#include "Engine/Core/EngineCommon.hpp"
-#include "Engine/Core/Rgba8.hpp"
-#include "Engine/Math/Vec3.hpp"
-#include "Engine/Math/EulerAngles.hpp"
-
-
-//forward declarations
-class CPUMesh;
-class GPUMesh;
-class Shader;
-
-
-class Model
-{
-//public member functions
-public:
-	Model();
-	~Model();
-	
-	//model creation and rendering
-	bool ParseXMLFileForOBJ(std::string const& fileName);
-	void RenderGPUMesh(Vec3 sunDirection, float sunIntensity, float ambientIntensity, Vec3 position, EulerAngles orientation, Rgba8 color) const;
-
-//public member variables
-public:
-	CPUMesh* m_cpuMesh = nullptr;
-	GPUMesh* m_gpuMesh = nullptr;
-	Shader*  m_shader = nullptr;
-};
+#pragma once
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Game/QuantizedMesh.hpp"
+#include "Engine/Core/Vertex_PCUTBN.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Math/EulerAngles.hpp"
+
+
+//forward declarations
+class CPUMesh;
+class Shader;
+class VertexBuffer;
+class IndexBuffer;
+class RenderQueue;
+class SoftwareRenderer;
+
+
+//lower detail levels are kept at these fractions of the full triangle count, and used below these projected sizes
+constexpr int MODEL_NUM_LODS = 3;
+constexpr float MODEL_LOD_TRIANGLE_FRACTIONS[MODEL_NUM_LODS] = { 1.0f, 0.4f, 0.15f };
+constexpr float MODEL_LOD_MIN_SCREEN_FRACTIONS[MODEL_NUM_LODS] = { 0.08f, 0.03f, 0.0f };
+
+//an instance already at some level of detail has to get this far past a threshold to cross it, so one sitting right on it doesn't flicker between levels
+constexpr float MODEL_LOD_SWITCH_TO_LOWER_FACTOR = 0.9f;
+constexpr float MODEL_LOD_SWITCH_TO_HIGHER_FACTOR = 1.1f;
+
+
+struct ModelInstance
+{
+	Vec3		m_position;
+	EulerAngles m_orientation;
+	Rgba8		m_color;
+
+	bool operator==(ModelInstance const& other) const;
+	bool operator!=(ModelInstance const& other) const;
+};
+
+
+struct ModelLOD
+{
+	QuantizedMesh m_mesh;
+
+	//every instance of the model baked in at this level of detail, each one a contiguous range of verts
+	//the index buffer only holds the instances drawn at this level, packed together, so the whole level is always a single draw
+	//only the GPU buffers are kept, the baked verts and packed indexes are scratch that goes away once they're uploaded
+	mutable int			  m_numBatchVerts = 0;
+	mutable int			  m_numBatchIndexes = 0;
+	mutable VertexBuffer* m_batchVertexBuffer = nullptr;
+	mutable IndexBuffer*  m_batchIndexBuffer = nullptr;
+};
+
+
+class Model
+{
+//public member functions
+public:
+	Model();
+	~Model();
+	
+	//model creation and rendering
+	bool ParseXMLFileForOBJ(std::string const& fileName);
+	void SubmitInstances(RenderQueue& renderQueue, std::vector<ModelInstance> const& instances, std::vector<int> const& instanceLODs) const;
+	void RenderSoftware(SoftwareRenderer& renderer, std::vector<ModelInstance> const& instances) const;
+
+	//accessors
+	size_t GetBatchGPUBytes() const;
+
+//private member functions
+private:
+	void GenerateLODs();
+	void RebuildInstanceBatches(std::vector<ModelInstance> const& instances) const;
+	void RebuildInstanceBatch(ModelLOD const& lod, std::vector<ModelInstance> const& instances, std::vector<Vertex_PCUTBN>& meshVerts, std::vector<Vertex_PCUTBN>& batchVerts) const;
+	void RebuildDrawnIndexes(std::vector<int> const& instanceLODs) const;
+
+//public member variables
+public:
+	CPUMesh* m_cpuMesh = nullptr;
+	Shader*  m_shader = nullptr;
+	float	 m_boundingRadius = 0.0f;
+	float	 m_acmr = 0.0f;	//post-transform cache misses per triangle after load-time optimization
+
+	//simplified copies of the mesh, from full detail down
+	ModelLOD m_lods[MODEL_NUM_LODS];
+
+	//the instances every LOD batch was last built from, so the batches only change when the units themselves do,
+	//and the LODs the index buffers were last packed for, so those only change when culling or LOD selection does
+	mutable std::vector<ModelInstance> m_batchInstances;
+	mutable std::vector<int>		   m_batchInstanceLODs;
+
+//public static functions
+public:
+	static int GetLODIndexForScreenFraction(float screenFraction, int currentLODIndex = -1);
+};
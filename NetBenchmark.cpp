@@ -0,0 +1,206 @@
+#include "Game/NetBenchmark.hpp"
+#include "Game/NetProtocol.hpp"
+#include "Game/NetUdpTransport.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+
+//
+//helper functions
+//
+static double GetPercentile(std::vector<double> const& sortedValues, double fraction)
+{
+	if (sortedValues.empty())
+	{
+		return 0.0;
+	}
+
+	//nearest rank, so a percentile is always a value that was actually measured
+	int rank = static_cast<int>(ceil(fraction * static_cast<double>(sortedValues.size())));
+	return sortedValues[std::clamp(rank - 1, 0, static_cast<int>(sortedValues.size()) - 1)];
+}
+
+
+//
+//constructor
+//
+NetBenchmark::NetBenchmark(NetBenchmarkConfig const& config, uint32_t runID)
+	: m_config(config)
+	, m_runID(runID)
+{
+	//the run ID leads the payload, and the rest is filler up to the requested size
+	AppendVarint(m_payload, m_runID);
+	if (static_cast<int>(m_payload.size()) < m_config.m_payloadBytes)
+	{
+		m_payload.resize(m_config.m_payloadBytes, 'x');
+	}
+	m_config.m_payloadBytes = static_cast<int>(m_payload.size());
+
+	if (m_config.m_numMessages > 0)
+	{
+		m_sendTimes.reserve(m_config.m_numMessages);
+		m_roundTripSeconds.reserve(m_config.m_numMessages);
+	}
+
+	m_startTime = GetCurrentTimeSeconds();
+	m_numBytesSentAtStart = g_theNetProtocol->m_numBytesSent;
+}
+
+
+//
+//game flow functions
+//
+void NetBenchmark::Update()
+{
+	if (m_isFinished)
+	{
+		return;
+	}
+
+	double currentTime = GetCurrentTimeSeconds();
+	SendPings(currentTime);
+
+	bool isPastDuration = m_config.m_durationSeconds > 0.0 && currentTime - m_startTime >= m_config.m_durationSeconds;
+	bool isDoneSending = isPastDuration || (m_config.m_numMessages > 0 && static_cast<int>(m_sendTimes.size()) >= m_config.m_numMessages);
+	if (isDoneSending && (m_numReplies == static_cast<int>(m_sendTimes.size()) || currentTime - m_lastSendTime >= m_config.m_timeoutSeconds))
+	{
+		Finish(currentTime);
+	}
+}
+
+
+//
+//reply functions
+//
+void NetBenchmark::ReceiveReply(int sequence, std::string_view payload)
+{
+	uint32_t runID = 0;
+	size_t offset = 0;
+	if (!ReadVarint(reinterpret_cast<unsigned char const*>(payload.data()), payload.size(), offset, runID) || runID != m_runID)
+	{
+		return;
+	}
+
+	if (m_isFinished || sequence < 0 || sequence >= static_cast<int>(m_sendTimes.size()) || m_roundTripSeconds[sequence] >= 0.0)
+	{
+		return;
+	}
+
+	m_lastReplyTime = GetCurrentTimeSeconds();
+	m_roundTripSeconds[sequence] = m_lastReplyTime - m_sendTimes[sequence];
+	m_numReplies++;
+}
+
+
+//
+//query functions
+//
+bool NetBenchmark::IsFinished() const
+{
+	return m_isFinished;
+}
+
+
+//
+//private member functions
+//
+void NetBenchmark::SendPings(double currentTime)
+{
+	double elapsedSeconds = currentTime - m_startTime;
+	if (m_config.m_durationSeconds > 0.0 && elapsedSeconds >= m_config.m_durationSeconds)
+	{
+		return;
+	}
+
+	int numDue = m_config.m_numMessages;
+	if (m_config.m_messagesPerSecond > 0.f)
+	{
+		numDue = static_cast<int>(elapsedSeconds * static_cast<double>(m_config.m_messagesPerSecond)) + 1;
+		if (m_config.m_numMessages > 0)
+		{
+			numDue = std::min(numDue, m_config.m_numMessages);
+		}
+	}
+
+	NetMessage message;
+	message.m_opcode = NetOpcode::BENCHMARK_PING;
+	message.m_payload = m_payload;
+	while (static_cast<int>(m_sendTimes.size()) < numDue)
+	{
+		message.m_value = static_cast<int>(m_sendTimes.size());
+		m_sendTimes.push_back(currentTime);
+		m_roundTripSeconds.push_back(-1.0);
+		g_theNetProtocol->QueueMessage(message);
+		m_lastSendTime = currentTime;
+	}
+}
+
+
+void NetBenchmark::Finish(double currentTime)
+{
+	m_isFinished = true;
+
+	std::vector<double> sortedRoundTrips;
+	sortedRoundTrips.reserve(m_numReplies);
+	for (int sequence = 0; sequence < m_roundTripSeconds.size(); sequence++)
+	{
+		if (m_roundTripSeconds[sequence] >= 0.0)
+		{
+			sortedRoundTrips.push_back(m_roundTripSeconds[sequence]);
+		}
+	}
+	std::sort(sortedRoundTrips.begin(), sortedRoundTrips.end());
+
+	double p50Ms = 1000.0 * GetPercentile(sortedRoundTrips, 0.5);
+	double p99Ms = 1000.0 * GetPercentile(sortedRoundTrips, 0.99);
+	double p999Ms = 1000.0 * GetPercentile(sortedRoundTrips, 0.999);
+	double maxMs = sortedRoundTrips.empty() ? 0.0 : 1000.0 * sortedRoundTrips.back();
+
+	//throughput is over the time traffic was actually flowing, not the timeout spent waiting on replies that never came
+	int numSent = static_cast<int>(m_sendTimes.size());
+	int numLost = numSent - m_numReplies;
+	double activeSeconds = std::max(m_lastSendTime, m_lastReplyTime) - m_startTime;
+	double repliesPerSecond = activeSeconds > 0.0 ? m_numReplies / activeSeconds : 0.0;
+	double payloadBytesPerSecond = repliesPerSecond * static_cast<double>(m_config.m_payloadBytes);
+	int numWireBytesSent = g_theNetProtocol->m_numBytesSent - m_numBytesSentAtStart;
+	double wireBytesPerSecond = activeSeconds > 0.0 ? numWireBytesSent / activeSeconds : 0.0;
+
+	bool isUdp = g_theNetProtocol->m_transport == NetTransport::UDP;
+	bool isText = g_theNetProtocol->m_mode == NetProtocolMode::TEXT;
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MAJOR, Stringf("Net benchmark over %s %s, %i byte payloads, %.2fs:", isUdp ? "UDP" : "TCP", isText ? "text" : "binary",
+		m_config.m_payloadBytes, currentTime - m_startTime));
+	g_theDevConsole->AddLine(numLost > 0 ? DevConsole::COLOR_ERROR : DevConsole::COLOR_INFO_MINOR, Stringf(" Messages:   %i sent, %i replies, %i lost", numSent, m_numReplies, numLost));
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, Stringf(" Round trip: p50 %.2fms, p99 %.2fms, p99.9 %.2fms, max %.2fms", p50Ms, p99Ms, p999Ms, maxMs));
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, Stringf(" Throughput: %.1f msgs/s, %.0f payload bytes/s round trip, %.0f wire bytes/s sent", repliesPerSecond,
+		payloadBytesPerSecond, wireBytesPerSecond));
+
+	//one row per run, along with the link conditions it ran under, so runs can be compared side by side
+	NetConditionerConfig simConfig;
+	if (g_theNetProtocol->m_udpTransport != nullptr)
+	{
+		simConfig = g_theNetProtocol->m_udpTransport->m_conditioner.m_config;
+	}
+
+	bool hasHeader = std::ifstream(m_config.m_csvPath).good();
+	std::ofstream file(m_config.m_csvPath, std::ios::app);
+	if (!file.good())
+	{
+		g_theDevConsole->AddLine(DevConsole::COLOR_ERROR, Stringf("Could not write net benchmark results to %s", m_config.m_csvPath.c_str()));
+		return;
+	}
+
+	if (!hasHeader)
+	{
+		file << "transport,protocol,payload_bytes,rate,duration_s,sent,replies,lost,p50_ms,p99_ms,p999_ms,max_ms,msgs_per_s,payload_bytes_per_s,wire_bytes_per_s,"
+			"sim_latency_ms,sim_jitter_ms,sim_loss_pct,sim_bandwidth_kbps\n";
+	}
+	file << Stringf("%s,%s,%i,%.1f,%.3f,%i,%i,%i,%.3f,%.3f,%.3f,%.3f,%.1f,%.0f,%.0f,%.0f,%.0f,%.1f,%i\n", isUdp ? "udp" : "tcp", isText ? "text" : "binary",
+		m_config.m_payloadBytes, m_config.m_messagesPerSecond, activeSeconds, numSent, m_numReplies, numLost, p50Ms, p99Ms, p999Ms, maxMs, repliesPerSecond, payloadBytesPerSecond,
+		wireBytesPerSecond, simConfig.m_isEnabled ? 1000.0 * simConfig.m_latencySeconds : 0.0, simConfig.m_isEnabled ? 1000.0 * simConfig.m_jitterSeconds : 0.0,
+		simConfig.m_isEnabled ? 100.f * simConfig.m_lossChance : 0.f, simConfig.m_isEnabled ? simConfig.m_bandwidthBytesPerSecond * 8 / 1000 : 0);
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, Stringf(" Results appended to %s", m_config.m_csvPath.c_str()));
+}
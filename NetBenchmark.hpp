@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+struct NetBenchmarkConfig
+{
+	int			m_numMessages = 1000;
+	int			m_payloadBytes = 32;
+	float		m_messagesPerSecond = 0.f;
+	double		m_durationSeconds = 0.0;
+	double		m_timeoutSeconds = 2.0;
+	std::string m_csvPath = "Data/NetBenchmark.csv";
+};
+
+
+//round trip benchmark against the other player: pings go out through the normal authoritative path, get echoed straight back,
+//and each reply is timed against its ping, so the results include the frame batching every real command goes through
+//a rate of 0 sends every message in the first frame, and a duration cuts sending off early, or replaces the message count if that's 0
+//every ping carries its run's ID, so stragglers from an earlier run that timed out never count toward this one
+class NetBenchmark
+{
+//public member functions
+public:
+	//constructor
+	NetBenchmark(NetBenchmarkConfig const& config, uint32_t runID);
+
+	//game flow functions
+	void Update();
+
+	//reply functions
+	void ReceiveReply(int sequence, std::string_view payload);
+
+	//query functions
+	bool IsFinished() const;
+
+//private member functions
+private:
+	void SendPings(double currentTime);
+	void Finish(double currentTime);
+
+//public member variables
+public:
+	NetBenchmarkConfig m_config;
+
+//private member variables
+private:
+	uint32_t	m_runID = 0;
+	std::string m_payload;
+	bool		m_isFinished = false;
+
+	double m_startTime = 0.0;
+	double m_lastSendTime = 0.0;
+	double m_lastReplyTime = 0.0;
+	int	   m_numBytesSentAtStart = 0;
+
+	//indexed by sequence, with a negative round trip for pings still waiting on their reply
+	std::vector<double> m_sendTimes;
+	std::vector<double> m_roundTripSeconds;
+	int					m_numReplies = 0;
+};
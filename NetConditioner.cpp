@@ -0,0 +1,135 @@
+#include "Game/NetConditioner.hpp"
+#include <algorithm>
+
+
+//a reordered datagram is held back at least this long, so reordering still happens on a link with no latency configured
+constexpr double NET_CONDITIONER_MIN_REORDER_SECONDS = 0.01;
+
+
+//
+//constructor
+//
+NetConditioner::NetConditioner(NetConditionerConfig const& config)
+	: m_config(config)
+	, m_randomEngine(config.m_seed)
+{
+}
+
+
+//
+//datagram functions
+//
+void NetConditioner::Submit(unsigned char const* bytes, int numBytes, uint32_t address, uint16_t port, double currentTime)
+{
+	if (RollChance(m_config.m_lossChance))
+	{
+		m_numDatagramsDropped++;
+		return;
+	}
+
+	//with a bandwidth cap, each datagram waits for the ones ahead of it to finish sending, and a link already backed up
+	//past the queue limit drops it the way a full router buffer would
+	double departureTime = currentTime;
+	if (m_config.m_bandwidthBytesPerSecond > 0)
+	{
+		double sendStartTime = std::max(currentTime, m_linkFreeTime);
+		if (sendStartTime - currentTime > m_config.m_maxQueueSeconds)
+		{
+			m_numDatagramsOverflowed++;
+			return;
+		}
+
+		m_linkFreeTime = sendStartTime + static_cast<double>(numBytes) / static_cast<double>(m_config.m_bandwidthBytesPerSecond);
+		departureTime = m_linkFreeTime;
+	}
+
+	double releaseTime = departureTime + RollDelaySeconds();
+	if (RollChance(m_config.m_reorderChance))
+	{
+		releaseTime += std::max(m_config.m_latencySeconds + m_config.m_jitterSeconds, NET_CONDITIONER_MIN_REORDER_SECONDS);
+		m_numDatagramsReordered++;
+	}
+	else
+	{
+		releaseTime = std::max(releaseTime, m_lastInOrderReleaseTime);
+		m_lastInOrderReleaseTime = releaseTime;
+	}
+
+	Schedule(bytes, numBytes, address, port, releaseTime);
+
+	//the copy trails the original, the way a datagram duplicated somewhere along the route would
+	if (RollChance(m_config.m_duplicateChance))
+	{
+		Schedule(bytes, numBytes, address, port, releaseTime);
+		m_numDatagramsDuplicated++;
+	}
+}
+
+
+bool NetConditioner::PopReleased(double currentTime, NetDelayedDatagram& outDatagram)
+{
+	if (m_delayedDatagrams.empty() || m_delayedDatagrams.top().m_releaseTime > currentTime)
+	{
+		return false;
+	}
+
+	outDatagram = m_delayedDatagrams.top();
+	m_delayedDatagrams.pop();
+	return true;
+}
+
+
+void NetConditioner::Clear()
+{
+	m_delayedDatagrams = {};
+	m_linkFreeTime = 0.0;
+	m_lastInOrderReleaseTime = 0.0;
+}
+
+
+//
+//query functions
+//
+bool NetConditioner::IsEnabled() const
+{
+	return m_config.m_isEnabled;
+}
+
+
+//
+//private member functions
+//
+bool NetConditioner::RollChance(float chance)
+{
+	if (chance <= 0.f)
+	{
+		return false;
+	}
+
+	std::uniform_real_distribution<float> distribution(0.f, 1.f);
+	return distribution(m_randomEngine) < chance;
+}
+
+
+double NetConditioner::RollDelaySeconds()
+{
+	if (m_config.m_jitterSeconds <= 0.0)
+	{
+		return m_config.m_latencySeconds;
+	}
+
+	std::uniform_real_distribution<double> distribution(-m_config.m_jitterSeconds, m_config.m_jitterSeconds);
+	return std::max(m_config.m_latencySeconds + distribution(m_randomEngine), 0.0);
+}
+
+
+void NetConditioner::Schedule(unsigned char const* bytes, int numBytes, uint32_t address, uint16_t port, double releaseTime)
+{
+	NetDelayedDatagram datagram;
+	datagram.m_releaseTime = releaseTime;
+	datagram.m_submitIndex = m_nextSubmitIndex++;
+	datagram.m_address = address;
+	datagram.m_port = port;
+	datagram.m_bytes.assign(reinterpret_cast<char const*>(bytes), numBytes);
+	m_delayedDatagrams.push(std::move(datagram));
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+
+struct NetConditionerConfig
+{
+	bool	 m_isEnabled = false;
+	double	 m_latencySeconds = 0.0;
+	double	 m_jitterSeconds = 0.0;
+	float	 m_lossChance = 0.f;
+	float	 m_duplicateChance = 0.f;
+	float	 m_reorderChance = 0.f;
+	int		 m_bandwidthBytesPerSecond = 0;
+	double	 m_maxQueueSeconds = 1.0;
+	uint32_t m_seed = 0;
+};
+
+
+//a datagram held back until the simulated link would have delivered it
+struct NetDelayedDatagram
+{
+	double		m_releaseTime = 0.0;
+	uint32_t	m_submitIndex = 0;
+	uint32_t	m_address = 0;
+	uint16_t	m_port = 0;
+	std::string m_bytes;
+};
+
+
+//stand-in for a real network between the transport and its socket, for testing two instances over loopback
+//outgoing datagrams are dropped, duplicated, delayed, and squeezed through a bandwidth cap here before they ever reach the socket,
+//so conditioning both instances gives each direction of the link its own conditions
+//jitter alone never reorders datagrams, only the reorder chance does, by holding one back for an extra latency's worth of time
+//only the i/o thread touches it, apart from the stats
+class NetConditioner
+{
+//public member functions
+public:
+	//constructor
+	explicit NetConditioner(NetConditionerConfig const& config);
+
+	//datagram functions
+	void Submit(unsigned char const* bytes, int numBytes, uint32_t address, uint16_t port, double currentTime);
+	bool PopReleased(double currentTime, NetDelayedDatagram& outDatagram);
+	void Clear();
+
+	//query functions
+	bool IsEnabled() const;
+
+//private member functions
+private:
+	bool   RollChance(float chance);
+	double RollDelaySeconds();
+	void   Schedule(unsigned char const* bytes, int numBytes, uint32_t address, uint16_t port, double releaseTime);
+
+//public member variables
+public:
+	NetConditionerConfig m_config;
+
+	//stats
+	std::atomic<int> m_numDatagramsDropped = 0;
+	std::atomic<int> m_numDatagramsDuplicated = 0;
+	std::atomic<int> m_numDatagramsReordered = 0;
+	std::atomic<int> m_numDatagramsOverflowed = 0;
+
+//private member variables
+private:
+	struct LaterRelease
+	{
+		bool operator()(NetDelayedDatagram const& a, NetDelayedDatagram const& b) const
+		{
+			return a.m_releaseTime != b.m_releaseTime ? a.m_releaseTime > b.m_releaseTime : a.m_submitIndex > b.m_submitIndex;
+		}
+	};
+
+	std::priority_queue<NetDelayedDatagram, std::vector<NetDelayedDatagram>, LaterRelease> m_delayedDatagrams;
+	std::mt19937 m_randomEngine;
+	uint32_t	 m_nextSubmitIndex = 0;
+
+	//when the simulated link finishes sending everything submitted so far, and the latest in-order release time handed out
+	double m_linkFreeTime = 0.0;
+	double m_lastInOrderReleaseTime = 0.0;
+};
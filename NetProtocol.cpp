@@ -0,0 +1,1618 @@
+#include "Game/NetProtocol.hpp"
+#include "Game/Game.hpp"
+#include "Game/Map.hpp"
+#include "Game/MapSnapshot.hpp"
+#include "Game/NetBenchmark.hpp"
+#include "Game/NetUdpTransport.hpp"
+#include "Engine/Core/NetSystem.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+
+//binary messages ride inside a single console command, since the net system's messages are null-terminated strings
+constexpr char const* NET_BINARY_COMMAND_NAME = "NetBin";
+constexpr char const* NET_BINARY_DATA_NAME = "Data";
+constexpr char const* NET_LOCKSTEP_COMMAND_NAME = "NetLockstep";
+constexpr char const* NET_PAYLOAD_COMMAND_NAME = "NetPayload";
+constexpr char const* NET_DESYNC_LOG_PATH = "Data/Desync.txt";
+constexpr int NET_STATE_HASH_BYTES = 8;
+constexpr int NET_NUM_RECENT_STATE_DUMPS = 64;
+constexpr size_t NET_BINARY_COMMAND_OVERHEAD_BYTES = 13;
+constexpr size_t NET_MIN_SEND_BUFFER_BYTES = 64;
+constexpr int NET_BENCHMARK_NUM_MESSAGES = 100000;
+constexpr int NET_BENCHMARK_MESSAGES_PER_BATCH = 20;
+constexpr int NET_BENCHMARK_PING_OVERHEAD_BYTES = 16;
+
+static char const BASE64_URL_ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+
+//
+//command handlers
+//
+static EventArgs s_noEventArgs;
+
+
+//commands without arguments go straight to their event handlers, sharing one empty set of args so nothing is built per message
+template <EventCallbackFunction EVENT_HANDLER>
+static void CallWithoutArgs(NetCommandArgs const& args)
+{
+	UNUSED(args);
+	EVENT_HANDLER(s_noEventArgs);
+}
+
+
+static void HandleSelectHex(NetCommandArgs const& args)
+{
+	if (g_theGame != nullptr && g_theGame->m_currentMap != nullptr)
+	{
+		g_theGame->m_currentMap->SelectHex(args.GetValue("TileIndex", -1));
+	}
+}
+
+
+static void HandleBarrierAck(NetCommandArgs const& args)
+{
+	if (g_theNetProtocol != nullptr)
+	{
+		g_theNetProtocol->ReceiveBarrierAck(static_cast<uint32_t>(args.GetValue("Sequence", 0)));
+	}
+}
+
+
+static void HandleStateDumpRequest(NetCommandArgs const& args)
+{
+	if (g_theNetProtocol != nullptr)
+	{
+		g_theNetProtocol->SendStateDump(args.GetValue("CommandIndex", -1));
+	}
+}
+
+
+static void HandleStateDump(NetCommandArgs const& args)
+{
+	if (g_theNetProtocol != nullptr)
+	{
+		g_theNetProtocol->ReceiveStateDump(args.m_payload);
+	}
+}
+
+
+static void HandleStateSnapshot(NetCommandArgs const& args)
+{
+	if (g_theNetProtocol != nullptr)
+	{
+		g_theNetProtocol->ReceiveSnapshot(args.m_payload);
+	}
+}
+
+
+//the reply carries the ping's sequence and payload straight back, so the benchmark on the other end can tell which ping it answers
+static void HandleBenchmarkPing(NetCommandArgs const& args)
+{
+	if (g_theNetProtocol != nullptr)
+	{
+		NetMessage reply;
+		reply.m_opcode = NetOpcode::BENCHMARK_PONG;
+		reply.m_value = args.GetValue("Sequence", 0);
+		reply.m_payload = args.m_payload;
+		g_theNetProtocol->QueueMessage(reply);
+	}
+}
+
+
+static void HandleBenchmarkPong(NetCommandArgs const& args)
+{
+	if (g_theNetProtocol != nullptr && g_theNetProtocol->m_benchmark != nullptr)
+	{
+		g_theNetProtocol->m_benchmark->ReceiveReply(args.GetValue("Sequence", -1), args.m_payload);
+	}
+}
+
+
+static void HandleEcho(NetCommandArgs const& args)
+{
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, Stringf("Echo: %i", args.GetValue("Message", 0)));
+}
+
+
+static NetCommandInfo const s_netCommandTable[] =
+{
+	{ NetOpcode::INVALID,				nullptr,				nullptr,		nullptr,										NetChannel::AUTHORITATIVE,	false },
+	{ NetOpcode::START_TURN,			"StartTurn",			nullptr,		CallWithoutArgs<Map::Event_StartTurn>,			NetChannel::AUTHORITATIVE,	true },
+	{ NetOpcode::SELECT_HEX,			"SelectHex",			"TileIndex",	HandleSelectHex,								NetChannel::COSMETIC,		false },
+	{ NetOpcode::SELECT_UNIT,			"SelectUnit",			nullptr,		CallWithoutArgs<Map::Event_SelectUnit>,			NetChannel::AUTHORITATIVE,	true },
+	{ NetOpcode::SELECT_FIRST_UNIT,		"SelectFirstUnit",		nullptr,		CallWithoutArgs<Map::Event_SelectFirstUnit>,	NetChannel::AUTHORITATIVE,	true },
+	{ NetOpcode::SELECT_LAST_UNIT,		"SelectLastUnit",		nullptr,		CallWithoutArgs<Map::Event_SelectLastUnit>,		NetChannel::AUTHORITATIVE,	true },
+	{ NetOpcode::SELECT_PREVIOUS_UNIT,	"SelectPreviousUnit",	nullptr,		CallWithoutArgs<Map::Event_SelectPreviousUnit>,	NetChannel::AUTHORITATIVE,	true },
+	{ NetOpcode::SELECT_NEXT_UNIT,		"SelectNextUnit",		nullptr,		CallWithoutArgs<Map::Event_SelectNextUnit>,		NetChannel::AUTHORITATIVE,	true },
+	{ NetOpcode::MOVE_UNIT,				"MoveUnit",				nullptr,		CallWithoutArgs<Map::Event_MoveUnit>,			NetChannel::AUTHORITATIVE,	true },
+	{ NetOpcode::CONFIRM_MOVE,			"ConfirmMove",			nullptr,		CallWithoutArgs<Map::Event_ConfirmMove>,		NetChannel::AUTHORITATIVE,	true },
+	{ NetOpcode::ATTACK,				"Attack",				nullptr,		CallWithoutArgs<Map::Event_Attack>,				NetChannel::AUTHORITATIVE,	true },
+	{ NetOpcode::CONFIRM_ATTACK,		"ConfirmAttack",		nullptr,		CallWithoutArgs<Map::Event_ConfirmAttack>,		NetChannel::AUTHORITATIVE,	true },
+	{ NetOpcode::CANCEL_MOVE,			"CancelMove",			nullptr,		CallWithoutArgs<Map::Event_CancelMove>,			NetChannel::AUTHORITATIVE,	true },
+	{ NetOpcode::END_TURN,				"EndTurn",				nullptr,		CallWithoutArgs<Map::Event_EndTurn>,			NetChannel::AUTHORITATIVE,	true },
+	{ NetOpcode::CONFIRM_END,			"ConfirmEnd",			nullptr,		CallWithoutArgs<Map::Event_ConfirmEnd>,			NetChannel::AUTHORITATIVE,	true },
+	{ NetOpcode::CANCEL_END,			"CancelEnd",			nullptr,		CallWithoutArgs<Map::Event_CancelEnd>,			NetChannel::AUTHORITATIVE,	true },
+	{ NetOpcode::REMOTE_PLAYER_READY,	"RemotePlayerReady",	nullptr,		CallWithoutArgs<Game::RemotePlayerReady>,		NetChannel::AUTHORITATIVE,	false },
+	{ NetOpcode::OTHER_PLAYER_QUIT,		"OtherPlayerQuit",		nullptr,		CallWithoutArgs<Game::OtherPlayerQuit>,			NetChannel::AUTHORITATIVE,	false },
+	{ NetOpcode::LOCKSTEP_BARRIER_ACK,	"LockstepBarrierAck",	"Sequence",		HandleBarrierAck,								NetChannel::AUTHORITATIVE,	false },
+	{ NetOpcode::STATE_DUMP_REQUEST,	"StateDumpRequest",		"CommandIndex",	HandleStateDumpRequest,							NetChannel::AUTHORITATIVE,	false },
+	{ NetOpcode::STATE_DUMP,			"StateDump",			nullptr,		HandleStateDump,								NetChannel::AUTHORITATIVE,	false },
+	{ NetOpcode::STATE_SNAPSHOT,		"StateSnapshot",		nullptr,		HandleStateSnapshot,							NetChannel::AUTHORITATIVE,	false },
+	{ NetOpcode::BENCHMARK_PING,		"BenchmarkPing",		"Sequence",		HandleBenchmarkPing,							NetChannel::AUTHORITATIVE,	false },
+	{ NetOpcode::BENCHMARK_PONG,		"BenchmarkPong",		"Sequence",		HandleBenchmarkPong,							NetChannel::AUTHORITATIVE,	false },
+	{ NetOpcode::ECHO,					"Echo",					"Message",		HandleEcho,										NetChannel::AUTHORITATIVE,	false },
+};
+static_assert(sizeof(s_netCommandTable) / sizeof(s_netCommandTable[0]) == static_cast<size_t>(NetOpcode::COUNT), "Net command table is out of sync with NetOpcode");
+static_assert(static_cast<unsigned char>(NetOpcode::COUNT) < NET_OPCODE_PAYLOAD_FLAG, "Opcodes overlap the opcode flag bits");
+
+
+//
+//varint helpers
+//
+void AppendVarint(std::string& bytes, uint32_t value)
+{
+	while (value >= 0x80)
+	{
+		bytes.push_back(static_cast<char>((value & 0x7F) | 0x80));
+		value >>= 7;
+	}
+	bytes.push_back(static_cast<char>(value));
+}
+
+
+bool ReadVarint(unsigned char const* bytes, size_t numBytes, size_t& inoutOffset, uint32_t& outValue)
+{
+	outValue = 0;
+	for (int shift = 0; shift < 35; shift += 7)
+	{
+		if (inoutOffset >= numBytes)
+		{
+			return false;
+		}
+
+		unsigned char byte = bytes[inoutOffset++];
+		outValue |= static_cast<uint32_t>(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+int GetVarintSize(uint32_t value)
+{
+	int numBytes = 1;
+	while (value >= 0x80)
+	{
+		value >>= 7;
+		numBytes++;
+	}
+	return numBytes;
+}
+
+
+//zigzag so small negative values like an empty tile index of -1 still fit in one byte
+uint32_t ZigZagEncode(int value)
+{
+	return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+}
+
+
+int ZigZagDecode(uint32_t value)
+{
+	return static_cast<int>(value >> 1) ^ -static_cast<int>(value & 1);
+}
+
+
+//
+//helper functions
+//
+static void AppendStateHash(std::string& bytes, uint64_t hash)
+{
+	for (int byteIndex = 0; byteIndex < NET_STATE_HASH_BYTES; byteIndex++)
+	{
+		bytes.push_back(static_cast<char>((hash >> (byteIndex * 8)) & 0xFF));
+	}
+}
+
+
+static bool ReadStateHash(unsigned char const* bytes, size_t numBytes, size_t& inoutOffset, uint64_t& outHash)
+{
+	if (numBytes - inoutOffset < NET_STATE_HASH_BYTES)
+	{
+		return false;
+	}
+
+	outHash = 0;
+	for (int byteIndex = 0; byteIndex < NET_STATE_HASH_BYTES; byteIndex++)
+	{
+		outHash |= static_cast<uint64_t>(bytes[inoutOffset++]) << (byteIndex * 8);
+	}
+	return true;
+}
+
+
+static size_t GetBase64UrlLength(size_t numBytes)
+{
+	return (numBytes * 8 + 5) / 6;
+}
+
+
+static std::string EncodeBase64Url(std::string_view bytes)
+{
+	std::string text;
+	text.reserve(GetBase64UrlLength(bytes.size()));
+
+	uint32_t bitBuffer = 0;
+	int numBufferedBits = 0;
+	for (int byteIndex = 0; byteIndex < bytes.size(); byteIndex++)
+	{
+		bitBuffer = (bitBuffer << 8) | static_cast<unsigned char>(bytes[byteIndex]);
+		numBufferedBits += 8;
+		while (numBufferedBits >= 6)
+		{
+			numBufferedBits -= 6;
+			text.push_back(BASE64_URL_ALPHABET[(bitBuffer >> numBufferedBits) & 0x3F]);
+		}
+	}
+	if (numBufferedBits > 0)
+	{
+		text.push_back(BASE64_URL_ALPHABET[(bitBuffer << (6 - numBufferedBits)) & 0x3F]);
+	}
+
+	return text;
+}
+
+
+static bool DecodeBase64Url(std::string const& text, std::string& outBytes)
+{
+	outBytes.clear();
+	outBytes.reserve(text.size() * 3 / 4);
+
+	uint32_t bitBuffer = 0;
+	int numBufferedBits = 0;
+	for (int charIndex = 0; charIndex < text.size(); charIndex++)
+	{
+		char character = text[charIndex];
+		int sextet = -1;
+		if (character >= 'A' && character <= 'Z') sextet = character - 'A';
+		else if (character >= 'a' && character <= 'z') sextet = character - 'a' + 26;
+		else if (character >= '0' && character <= '9') sextet = character - '0' + 52;
+		else if (character == '-') sextet = 62;
+		else if (character == '_') sextet = 63;
+		else return false;
+
+		bitBuffer = (bitBuffer << 6) | static_cast<uint32_t>(sextet);
+		numBufferedBits += 6;
+		if (numBufferedBits >= 8)
+		{
+			numBufferedBits -= 8;
+			outBytes.push_back(static_cast<char>((bitBuffer >> numBufferedBits) & 0xFF));
+		}
+	}
+
+	return true;
+}
+
+
+//
+//command args functions
+//
+bool NetCommandArgs::SetValue(std::string_view name, int value)
+{
+	for (int argIndex = 0; argIndex < m_numArgs; argIndex++)
+	{
+		if (m_names[argIndex] == name)
+		{
+			m_values[argIndex] = value;
+			return true;
+		}
+	}
+
+	if (m_numArgs >= NET_MAX_COMMAND_ARGS)
+	{
+		return false;
+	}
+
+	m_names[m_numArgs] = name;
+	m_values[m_numArgs] = value;
+	m_numArgs++;
+	return true;
+}
+
+
+int NetCommandArgs::GetValue(std::string_view name, int defaultValue) const
+{
+	for (int argIndex = 0; argIndex < m_numArgs; argIndex++)
+	{
+		if (m_names[argIndex] == name)
+		{
+			return m_values[argIndex];
+		}
+	}
+
+	return defaultValue;
+}
+
+
+//
+//constructor
+//
+NetProtocol::NetProtocol(NetProtocolMode mode, NetTransport transport)
+	: m_mode(mode)
+	, m_transport(transport)
+{
+	if (m_transport == NetTransport::UDP)
+	{
+		//datagrams carry raw bytes, so there's no text form to fall back to and a batch just has to fit in one datagram
+		m_mode = NetProtocolMode::BINARY;
+		m_maxBatchBytes = UDP_MAX_PAYLOAD_BYTES;
+
+		std::string modeString = g_gameConfigBlackboard.GetValue("netMode", "none");
+		if (modeString == "Client" || modeString == "Server")
+		{
+			UdpTransportConfig udpConfig;
+			udpConfig.m_isServer = modeString == "Server";
+			udpConfig.m_hostAddress = g_gameConfigBlackboard.GetValue("netHostAddress", udpConfig.m_hostAddress);
+			udpConfig.m_resendSeconds = static_cast<double>(g_gameConfigBlackboard.GetValue("netResendSeconds", static_cast<float>(udpConfig.m_resendSeconds)));
+
+			//simulated link conditions, applied to what each instance sends, so two conditioned instances over loopback behave like a real connection
+			//the seed is offset by role so two instances sharing one config still roll different losses
+			NetConditionerConfig& simConfig = udpConfig.m_conditionerConfig;
+			simConfig.m_isEnabled = g_gameConfigBlackboard.GetValue("netSimEnabled", simConfig.m_isEnabled);
+			simConfig.m_latencySeconds = 0.001 * static_cast<double>(g_gameConfigBlackboard.GetValue("netSimLatencyMs", 0.f));
+			simConfig.m_jitterSeconds = 0.001 * static_cast<double>(g_gameConfigBlackboard.GetValue("netSimJitterMs", 0.f));
+			simConfig.m_lossChance = 0.01f * g_gameConfigBlackboard.GetValue("netSimLossPercent", 0.f);
+			simConfig.m_duplicateChance = 0.01f * g_gameConfigBlackboard.GetValue("netSimDuplicatePercent", 0.f);
+			simConfig.m_reorderChance = 0.01f * g_gameConfigBlackboard.GetValue("netSimReorderPercent", 0.f);
+			simConfig.m_bandwidthBytesPerSecond = g_gameConfigBlackboard.GetValue("netSimBandwidthKbps", 0) * 1000 / 8;
+			simConfig.m_maxQueueSeconds = 0.001 * static_cast<double>(g_gameConfigBlackboard.GetValue("netSimMaxQueueMs", 1000.f));
+			simConfig.m_seed = static_cast<uint32_t>(g_gameConfigBlackboard.GetValue("netSimSeed", 0)) * 2 + (udpConfig.m_isServer ? 1 : 0);
+
+			m_udpTransport = new NetUdpTransport(udpConfig);
+			m_udpTransport->Startup();
+		}
+	}
+	else
+	{
+		//the wrapped batch, its command name, and the null terminator all have to fit in one send buffer
+		int sendBufferSize = g_gameConfigBlackboard.GetValue("netSendBufferSize", 1024);
+		GUARANTEE_OR_DIE(sendBufferSize >= static_cast<int>(NET_MIN_SEND_BUFFER_BYTES), Stringf("netSendBufferSize must be at least %i bytes to fit a batch of net commands!",
+			static_cast<int>(NET_MIN_SEND_BUFFER_BYTES)));
+		m_maxBatchBytes = (static_cast<size_t>(sendBufferSize) - NET_BINARY_COMMAND_OVERHEAD_BYTES) * 6 / 8;
+
+		//the engine's net system owns its sockets, so there's nowhere to put the conditioner in between
+		if (g_gameConfigBlackboard.GetValue("netSimEnabled", false))
+		{
+			g_theDevConsole->AddLine(DevConsole::COLOR_ERROR, "Simulated network conditions only apply to the UDP transport, ignoring netSim settings");
+		}
+	}
+	m_cosmeticBacklogLimit = g_gameConfigBlackboard.GetValue("netCosmeticBacklogLimit", m_cosmeticBacklogLimit);
+	m_isLockstepEnabled = g_gameConfigBlackboard.GetValue("netLockstep", m_isLockstepEnabled);
+	m_barrierTimeoutSeconds = static_cast<double>(g_gameConfigBlackboard.GetValue("netLockstepBarrierSeconds", static_cast<float>(m_barrierTimeoutSeconds)));
+
+	SubscribeEventCallbackFunction(NET_BINARY_COMMAND_NAME, Event_ReceiveBinaryCommands);
+	SubscribeEventCallbackFunction(NET_LOCKSTEP_COMMAND_NAME, Event_ReceiveLockstepCommand);
+	SubscribeEventCallbackFunction(NET_PAYLOAD_COMMAND_NAME, Event_ReceivePayloadCommand);
+	SubscribeEventCallbackFunction("NetProtocolBenchmark", Event_ProtocolBenchmark);
+	SubscribeEventCallbackFunction("NetStats", Event_PrintStats);
+	SubscribeEventCallbackFunction("NetResync", Event_Resync);
+}
+
+
+NetProtocol::~NetProtocol()
+{
+	if (m_benchmark != nullptr)
+	{
+		delete m_benchmark;
+		m_benchmark = nullptr;
+	}
+
+	if (m_desyncSnapshot != nullptr)
+	{
+		delete m_desyncSnapshot;
+		m_desyncSnapshot = nullptr;
+	}
+
+	if (m_udpTransport != nullptr)
+	{
+		m_udpTransport->Shutdown();
+		delete m_udpTransport;
+		m_udpTransport = nullptr;
+	}
+}
+
+
+//
+//game flow functions
+//
+void NetProtocol::BeginFrame()
+{
+	//the other player hasn't acked the end of our turn, so send everything since the last ack again; they drop what they already have
+	if (m_isAwaitingBarrierAck && GetCurrentTimeSeconds() - m_barrierSendTime >= m_barrierTimeoutSeconds)
+	{
+		ResendUnackedCommands();
+	}
+
+	if (m_transport == NetTransport::UDP)
+	{
+		if (m_udpTransport != nullptr)
+		{
+			m_udpTransport->BeginFrame();
+			for (int payloadIndex = 0; payloadIndex < m_udpTransport->m_receivedPayloads.size(); payloadIndex++)
+			{
+				UdpPayload const& payload = m_udpTransport->m_receivedPayloads[payloadIndex];
+				if (!DispatchBatch(payload.m_bytes, payload.m_numBytes))
+				{
+					g_theDevConsole->AddLine(DevConsole::COLOR_ERROR, "Received malformed UDP net batch!");
+				}
+			}
+		}
+		return;
+	}
+
+	//whatever the net system couldn't get out last frame is the backlog cosmetic traffic would have to queue behind
+	m_isSendQueueBackedUp = static_cast<int>(g_theNetSystem->m_sendQueue.size()) > m_cosmeticBacklogLimit;
+}
+
+
+void NetProtocol::EndFrame()
+{
+	if (m_benchmark != nullptr)
+	{
+		m_benchmark->Update();
+		if (m_benchmark->IsFinished())
+		{
+			delete m_benchmark;
+			m_benchmark = nullptr;
+		}
+	}
+
+	if (m_transport == NetTransport::UDP)
+	{
+		FlushSendBatch();
+
+		//cosmetic messages share one unreliable datagram, and anything that doesn't fit in it waits for the next frame
+		std::string cosmeticBatch;
+		int numMessagesQueued = 0;
+		for (; numMessagesQueued < m_pendingCosmeticMessages.size(); numMessagesQueued++)
+		{
+			size_t batchSize = cosmeticBatch.size();
+			AppendFramedMessage(m_pendingCosmeticMessages[numMessagesQueued], cosmeticBatch);
+			if (cosmeticBatch.size() > UDP_MAX_PAYLOAD_BYTES)
+			{
+				cosmeticBatch.resize(batchSize);
+				break;
+			}
+			m_numMessagesSent++;
+		}
+		m_pendingCosmeticMessages.erase(m_pendingCosmeticMessages.begin(), m_pendingCosmeticMessages.begin() + numMessagesQueued);
+
+		if (m_udpTransport != nullptr)
+		{
+			if (!cosmeticBatch.empty())
+			{
+				m_udpTransport->SendUnreliable(cosmeticBatch);
+				m_numBytesSent += static_cast<int>(cosmeticBatch.size()) + UDP_PACKET_HEADER_BYTES;
+			}
+		}
+		return;
+	}
+
+	//authoritative traffic is already queued ahead of this, so cosmetic traffic only ever fills in behind it
+	if (!m_isSendQueueBackedUp)
+	{
+		int numMessagesQueued = 0;
+		for (; numMessagesQueued < m_pendingCosmeticMessages.size(); numMessagesQueued++)
+		{
+			NetMessage const& message = m_pendingCosmeticMessages[numMessagesQueued];
+			if (m_mode == NetProtocolMode::TEXT)
+			{
+				std::string command = FormatMessageAsText(message);
+				m_numBytesSent += static_cast<int>(command.size()) + 1;
+				g_theNetSystem->m_sendQueue.emplace_back(command);
+			}
+			else
+			{
+				//anything that doesn't fit in this frame's batch waits for the next one
+				size_t batchSize = m_sendBatch.size();
+				AppendFramedMessage(message, m_sendBatch);
+				if (m_sendBatch.size() > m_maxBatchBytes)
+				{
+					m_sendBatch.resize(batchSize);
+					break;
+				}
+			}
+			m_numMessagesSent++;
+		}
+		m_pendingCosmeticMessages.erase(m_pendingCosmeticMessages.begin(), m_pendingCosmeticMessages.begin() + numMessagesQueued);
+	}
+
+	FlushSendBatch();
+}
+
+
+//
+//sending functions
+//
+void NetProtocol::SendCommand(NetOpcode opcode, int value)
+{
+	NetMessage message;
+	message.m_opcode = opcode;
+	message.m_value = value;
+
+	NetCommandInfo const* info = GetCommandInfo(opcode);
+	if (info != nullptr && info->m_channel == NetChannel::COSMETIC)
+	{
+		QueueCosmeticMessage(message);
+		return;
+	}
+
+	QueueMessage(message);
+}
+
+
+void NetProtocol::QueueMessage(NetMessage const& message)
+{
+	m_numMessagesSent++;
+
+	if (m_mode == NetProtocolMode::TEXT)
+	{
+		std::string command = FormatMessageAsText(message);
+		m_numBytesSent += static_cast<int>(command.size()) + 1;
+		g_theNetSystem->m_sendQueue.emplace_back(command);
+		return;
+	}
+
+	size_t batchSize = m_sendBatch.size();
+	AppendFramedMessage(message, m_sendBatch);
+	if (m_sendBatch.size() - batchSize > m_maxBatchBytes)
+	{
+		//only a message with a payload can get this big, and it could never go out in one piece
+		m_sendBatch.resize(batchSize);
+		ERROR_RECOVERABLE(Stringf("Net message with opcode %i is too large to send!", static_cast<int>(message.m_opcode)));
+		return;
+	}
+	if (m_sendBatch.size() > m_maxBatchBytes && batchSize > 0)
+	{
+		//send what was already batched and start a new batch with this message
+		std::string framedMessage = m_sendBatch.substr(batchSize);
+		m_sendBatch.resize(batchSize);
+		FlushSendBatch();
+		m_sendBatch = framedMessage;
+	}
+}
+
+
+void NetProtocol::QueueCosmeticMessage(NetMessage const& message)
+{
+	//latest wins, so a newer value for the same opcode replaces the one still waiting
+	for (int messageIndex = 0; messageIndex < m_pendingCosmeticMessages.size(); messageIndex++)
+	{
+		if (m_pendingCosmeticMessages[messageIndex].m_opcode == message.m_opcode)
+		{
+			m_pendingCosmeticMessages[messageIndex] = message;
+			m_numCosmeticMessagesReplaced++;
+			return;
+		}
+	}
+
+	m_pendingCosmeticMessages.emplace_back(message);
+}
+
+
+void NetProtocol::FlushSendBatch()
+{
+	if (m_sendBatch.empty())
+	{
+		return;
+	}
+
+	m_numBatchesSent++;
+	if (m_transport == NetTransport::UDP)
+	{
+		if (m_udpTransport != nullptr)
+		{
+			m_udpTransport->SendReliable(m_sendBatch);
+			m_numBytesSent += static_cast<int>(m_sendBatch.size()) + UDP_PACKET_HEADER_BYTES;
+		}
+		m_sendBatch.clear();
+		return;
+	}
+
+	std::string command = Stringf("%s %s=%s", NET_BINARY_COMMAND_NAME, NET_BINARY_DATA_NAME, EncodeBase64Url(m_sendBatch).c_str());
+	m_numBytesSent += static_cast<int>(command.size()) + 1;
+	g_theNetSystem->m_sendQueue.emplace_back(command);
+	m_sendBatch.clear();
+}
+
+
+void NetProtocol::RecordSuppressedCommand(NetOpcode opcode, int value)
+{
+	m_numMessagesSuppressed++;
+	m_numBytesSaved += GetCommandWireBytes(opcode, value);
+}
+
+
+//sized from the same layout FormatMessageAsText and AppendFramedMessage write, without building either, for unsequenced commands with no payload
+int NetProtocol::GetCommandWireBytes(NetOpcode opcode, int value) const
+{
+	NetCommandInfo const* info = GetCommandInfo(opcode);
+	if (info == nullptr)
+	{
+		return 0;
+	}
+
+	bool hasValue = info->m_valueName != nullptr;
+	if (m_mode == NetProtocolMode::TEXT)
+	{
+		//"Name Key=Value" plus the terminator
+		int numTextBytes = static_cast<int>(strlen(info->m_name)) + 1;
+		if (hasValue)
+		{
+			int numValueChars = value < 0 ? 2 : 1;
+			for (int remaining = abs(value / 10); remaining > 0; remaining /= 10)
+			{
+				numValueChars++;
+			}
+			numTextBytes += 1 + static_cast<int>(strlen(info->m_valueName)) + 1 + numValueChars;
+		}
+		return numTextBytes;
+	}
+
+	//what the message adds to a batch that is going out anyway: length prefix, opcode byte, and the value
+	int messageLength = 1 + (hasValue ? GetVarintSize(ZigZagEncode(value)) : 0);
+	int numFramedBytes = GetVarintSize(static_cast<uint32_t>(messageLength)) + messageLength;
+	if (m_transport == NetTransport::UDP)
+	{
+		return numFramedBytes;
+	}
+	return static_cast<int>(GetBase64UrlLength(static_cast<size_t>(numFramedBytes)));
+}
+
+
+//
+//encoding functions
+//
+void NetProtocol::EncodeMessage(NetMessage const& message, std::string& outBytes)
+{
+	unsigned char opcodeByte = static_cast<unsigned char>(message.m_opcode);
+	if (message.m_isSequenced)
+	{
+		opcodeByte |= NET_OPCODE_SEQUENCED_FLAG;
+	}
+	if (!message.m_payload.empty())
+	{
+		opcodeByte |= NET_OPCODE_PAYLOAD_FLAG;
+	}
+	outBytes.push_back(static_cast<char>(opcodeByte));
+
+	if (message.m_isSequenced)
+	{
+		AppendVarint(outBytes, message.m_sequence);
+		outBytes.push_back(static_cast<char>(message.m_playerID));
+		AppendVarint(outBytes, ZigZagEncode(message.m_tileIndex));
+		AppendStateHash(outBytes, message.m_stateHash);
+	}
+
+	NetCommandInfo const* info = GetCommandInfo(message.m_opcode);
+	if (info != nullptr && info->m_valueName != nullptr)
+	{
+		AppendVarint(outBytes, ZigZagEncode(message.m_value));
+	}
+
+	if (!message.m_payload.empty())
+	{
+		AppendVarint(outBytes, static_cast<uint32_t>(message.m_payload.size()));
+		outBytes.append(message.m_payload);
+	}
+}
+
+
+bool NetProtocol::DecodeMessage(unsigned char const* bytes, size_t numBytes, size_t& inoutOffset, NetMessage& outMessage)
+{
+	if (inoutOffset >= numBytes)
+	{
+		return false;
+	}
+
+	unsigned char opcodeByte = bytes[inoutOffset++];
+	outMessage = NetMessage();
+	outMessage.m_opcode = static_cast<NetOpcode>(opcodeByte & ~(NET_OPCODE_SEQUENCED_FLAG | NET_OPCODE_PAYLOAD_FLAG));
+
+	NetCommandInfo const* info = GetCommandInfo(outMessage.m_opcode);
+	if (info == nullptr)
+	{
+		return false;
+	}
+
+	if ((opcodeByte & NET_OPCODE_SEQUENCED_FLAG) != 0)
+	{
+		uint32_t encodedTileIndex = 0;
+		if (!ReadVarint(bytes, numBytes, inoutOffset, outMessage.m_sequence) || inoutOffset >= numBytes)
+		{
+			return false;
+		}
+		outMessage.m_playerID = bytes[inoutOffset++];
+		if (!ReadVarint(bytes, numBytes, inoutOffset, encodedTileIndex) || !ReadStateHash(bytes, numBytes, inoutOffset, outMessage.m_stateHash))
+		{
+			return false;
+		}
+		outMessage.m_isSequenced = true;
+		outMessage.m_tileIndex = ZigZagDecode(encodedTileIndex);
+	}
+
+	if (info->m_valueName != nullptr)
+	{
+		uint32_t encodedValue = 0;
+		if (!ReadVarint(bytes, numBytes, inoutOffset, encodedValue))
+		{
+			return false;
+		}
+		outMessage.m_value = ZigZagDecode(encodedValue);
+	}
+
+	if ((opcodeByte & NET_OPCODE_PAYLOAD_FLAG) != 0)
+	{
+		uint32_t payloadSize = 0;
+		if (!ReadVarint(bytes, numBytes, inoutOffset, payloadSize) || payloadSize > numBytes - inoutOffset)
+		{
+			return false;
+		}
+		outMessage.m_payload = std::string_view(reinterpret_cast<char const*>(bytes + inoutOffset), payloadSize);
+		inoutOffset += payloadSize;
+	}
+
+	return true;
+}
+
+
+void NetProtocol::AppendFramedMessage(NetMessage const& message, std::string& outBatch)
+{
+	//everything but a payload message fits in 127 bytes, so the length prefix is almost always a single varint byte
+	size_t lengthOffset = outBatch.size();
+	outBatch.push_back(0);
+	EncodeMessage(message, outBatch);
+
+	uint32_t messageLength = static_cast<uint32_t>(outBatch.size() - lengthOffset - 1);
+	if (messageLength < 0x80)
+	{
+		outBatch[lengthOffset] = static_cast<char>(messageLength);
+		return;
+	}
+
+	std::string lengthBytes;
+	AppendVarint(lengthBytes, messageLength);
+	outBatch.replace(lengthOffset, 1, lengthBytes);
+}
+
+
+bool NetProtocol::DispatchBatch(unsigned char const* bytes, size_t numBytes)
+{
+	//messages are decoded in place, each one bounded by its length prefix
+	size_t offset = 0;
+	while (offset < numBytes)
+	{
+		uint32_t messageLength = 0;
+		if (!ReadVarint(bytes, numBytes, offset, messageLength) || messageLength > numBytes - offset)
+		{
+			return false;
+		}
+
+		size_t messageEnd = offset + messageLength;
+		NetMessage message;
+		if (DecodeMessage(bytes, messageEnd, offset, message))
+		{
+			DispatchNetMessage(message);
+		}
+		else
+		{
+			g_theDevConsole->AddLine(DevConsole::COLOR_ERROR, "Received unknown binary net command!");
+		}
+		offset = messageEnd;
+	}
+
+	return true;
+}
+
+
+std::string NetProtocol::FormatMessageAsText(NetMessage const& message)
+{
+	NetCommandInfo const* info = GetCommandInfo(message.m_opcode);
+	if (info == nullptr)
+	{
+		return "";
+	}
+
+	if (message.m_isSequenced)
+	{
+		return Stringf("%s Op=%i Seq=%u Player=%i Tile=%i Hash=%llu Value=%i", NET_LOCKSTEP_COMMAND_NAME, static_cast<int>(message.m_opcode), message.m_sequence, message.m_playerID,
+			message.m_tileIndex, static_cast<unsigned long long>(message.m_stateHash), message.m_value);
+	}
+
+	if (!message.m_payload.empty())
+	{
+		return Stringf("%s Op=%i Value=%i %s=%s", NET_PAYLOAD_COMMAND_NAME, static_cast<int>(message.m_opcode), message.m_value, NET_BINARY_DATA_NAME,
+			EncodeBase64Url(message.m_payload).c_str());
+	}
+
+	if (info->m_valueName != nullptr)
+	{
+		return Stringf("%s %s=%i", info->m_name, info->m_valueName, message.m_value);
+	}
+
+	return info->m_name;
+}
+
+
+bool NetProtocol::ParseCommandText(std::string_view text, NetCommandInfo const*& outInfo, NetCommandArgs& outArgs)
+{
+	//"Name Key=Value Key=Value", tokenized in place
+	outArgs.m_numArgs = 0;
+	size_t tokenStart = text.find_first_not_of(' ');
+	if (tokenStart == std::string_view::npos)
+	{
+		return false;
+	}
+
+	size_t tokenEnd = text.find(' ', tokenStart);
+	outInfo = GetCommandInfo(text.substr(tokenStart, tokenEnd - tokenStart));
+	if (outInfo == nullptr)
+	{
+		return false;
+	}
+
+	while (tokenEnd != std::string_view::npos)
+	{
+		tokenStart = text.find_first_not_of(' ', tokenEnd);
+		if (tokenStart == std::string_view::npos)
+		{
+			break;
+		}
+		tokenEnd = text.find(' ', tokenStart);
+		std::string_view token = text.substr(tokenStart, tokenEnd - tokenStart);
+
+		size_t equalsIndex = token.find('=');
+		if (equalsIndex == std::string_view::npos)
+		{
+			continue;
+		}
+
+		std::string_view valueText = token.substr(equalsIndex + 1);
+		if (valueText.size() >= 2 && valueText.front() == '\"' && valueText.back() == '\"')
+		{
+			valueText = valueText.substr(1, valueText.size() - 2);
+		}
+
+		int value = 0;
+		std::from_chars_result result = std::from_chars(valueText.data(), valueText.data() + valueText.size(), value);
+		if (result.ec == std::errc() && !outArgs.SetValue(token.substr(0, equalsIndex), value))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+bool NetProtocol::ParseMessageFromText(std::string_view text, NetMessage& outMessage)
+{
+	NetCommandInfo const* info = nullptr;
+	NetCommandArgs args;
+	if (!ParseCommandText(text, info, args))
+	{
+		return false;
+	}
+
+	outMessage.m_opcode = info->m_opcode;
+	outMessage.m_value = info->m_valueName != nullptr ? args.GetValue(info->m_valueName, 0) : 0;
+	return true;
+}
+
+
+void NetProtocol::DispatchNetMessage(NetMessage const& message)
+{
+	NetCommandInfo const* info = GetCommandInfo(message.m_opcode);
+	if (info == nullptr)
+	{
+		return;
+	}
+
+	if (message.m_isSequenced)
+	{
+		if (g_theNetProtocol != nullptr)
+		{
+			g_theNetProtocol->ReceiveLoggedCommand(message);
+		}
+		return;
+	}
+
+	NetCommandArgs args;
+	if (info->m_valueName != nullptr)
+	{
+		args.SetValue(info->m_valueName, message.m_value);
+	}
+	args.m_payload = message.m_payload;
+
+	info->m_handler(args);
+}
+
+
+//
+//lockstep functions
+//
+void NetProtocol::IssueCommand(NetOpcode opcode)
+{
+	NetCommandInfo const* info = GetCommandInfo(opcode);
+	if (info == nullptr)
+	{
+		return;
+	}
+
+	if (!m_isLockstepEnabled || !info->m_isLogged)
+	{
+		NetCommandArgs args;
+		info->m_handler(args);
+		SendCommand(opcode);
+		return;
+	}
+
+	Map* map = g_theGame->m_currentMap;
+
+	NetMessage message;
+	message.m_opcode = opcode;
+	message.m_isSequenced = true;
+	message.m_sequence = m_nextLocalSequence;
+	message.m_playerID = g_theGame->m_playerID;
+	message.m_tileIndex = map->m_selectedTileCoords.x >= 0 ? map->GetTileIndex(map->m_selectedTileCoords) : -1;
+
+	//local commands go through the same pipeline as remote ones, so both sides apply exactly the same thing
+	//a command we rejected ourselves would only be rejected again on the other side, so it never takes a sequence number or goes out
+	if (!ApplyCommand(message))
+	{
+		return;
+	}
+	m_nextLocalSequence++;
+	message.m_stateHash = map->m_stateHash;
+	QueueMessage(message);
+
+	//hotseat games have no one to wait for
+	if (g_theGame->m_playerID == 0)
+	{
+		return;
+	}
+
+	m_unackedCommands.emplace_back(message);
+	if (opcode == NetOpcode::CONFIRM_END)
+	{
+		m_isAwaitingBarrierAck = true;
+		m_barrierSequence = message.m_sequence;
+		m_barrierSendTime = GetCurrentTimeSeconds();
+	}
+}
+
+
+bool NetProtocol::ApplyCommand(NetMessage const& message)
+{
+	if (g_theGame == nullptr || g_theGame->m_currentMap == nullptr)
+	{
+		return false;
+	}
+
+	Map* map = g_theGame->m_currentMap;
+	if (message.m_playerID != 0 && message.m_playerID != map->m_currentPlayerTurn)
+	{
+		m_numCommandsRejected++;
+		g_theDevConsole->AddLine(DevConsole::COLOR_ERROR, Stringf("Rejected lockstep command %u from player %i during player %i's turn!", message.m_sequence, message.m_playerID,
+			map->m_currentPlayerTurn));
+		return false;
+	}
+
+	//the command acts on the tile it was issued on, not on whatever the last hover update happened to leave selected
+	map->SelectHex(message.m_tileIndex);
+
+	//several commands can be applied in one frame, so the distance field is rebuilt here rather than trusted from the last Update
+	map->RefreshSelectedUnitState();
+
+	NetCommandArgs args;
+	GetCommandInfo(message.m_opcode)->m_handler(args);
+
+	//the log keeps our own hash after each command, whoever issued it
+	m_commandLog.emplace_back(message);
+	m_commandLog.back().m_stateHash = map->m_stateHash;
+
+	//a handful of bytes per command, and commands come at the pace of clicks
+	MapSnapshot snapshot;
+	snapshot.Capture(*map, static_cast<int>(m_commandLog.size()) - 1);
+	m_recentStateDumps.emplace_back();
+	snapshot.Serialize(m_recentStateDumps.back());
+	if (m_recentStateDumps.size() > NET_NUM_RECENT_STATE_DUMPS)
+	{
+		m_recentStateDumps.pop_front();
+	}
+	return true;
+}
+
+
+void NetProtocol::ReceiveLoggedCommand(NetMessage const& message)
+{
+	if (message.m_sequence < m_nextRemoteSequence)
+	{
+		//a resend of something already applied, but the ack for a turn end may have been what got lost
+		if (message.m_opcode == NetOpcode::CONFIRM_END)
+		{
+			SendCommand(NetOpcode::LOCKSTEP_BARRIER_ACK, static_cast<int>(message.m_sequence));
+		}
+		return;
+	}
+
+	if (message.m_sequence > m_nextRemoteSequence)
+	{
+		for (int commandIndex = 0; commandIndex < m_earlyRemoteCommands.size(); commandIndex++)
+		{
+			if (m_earlyRemoteCommands[commandIndex].m_sequence == message.m_sequence)
+			{
+				return;
+			}
+		}
+		m_earlyRemoteCommands.emplace_back(message);
+		return;
+	}
+
+	NetMessage nextMessage = message;
+	while (true)
+	{
+		if (ApplyCommand(nextMessage) && nextMessage.m_stateHash != g_theGame->m_currentMap->m_stateHash)
+		{
+			ReportDesync(nextMessage);
+		}
+		m_nextRemoteSequence++;
+		if (nextMessage.m_opcode == NetOpcode::CONFIRM_END)
+		{
+			SendCommand(NetOpcode::LOCKSTEP_BARRIER_ACK, static_cast<int>(nextMessage.m_sequence));
+		}
+
+		//anything that arrived ahead of this one may be next in line now
+		int earlyIndex = 0;
+		for (; earlyIndex < m_earlyRemoteCommands.size(); earlyIndex++)
+		{
+			if (m_earlyRemoteCommands[earlyIndex].m_sequence == m_nextRemoteSequence)
+			{
+				break;
+			}
+		}
+		if (earlyIndex == m_earlyRemoteCommands.size())
+		{
+			break;
+		}
+
+		nextMessage = m_earlyRemoteCommands[earlyIndex];
+		m_earlyRemoteCommands.erase(m_earlyRemoteCommands.begin() + earlyIndex);
+	}
+}
+
+
+void NetProtocol::ReceiveBarrierAck(uint32_t sequence)
+{
+	int numAckedCommands = 0;
+	for (; numAckedCommands < m_unackedCommands.size(); numAckedCommands++)
+	{
+		if (m_unackedCommands[numAckedCommands].m_sequence > sequence)
+		{
+			break;
+		}
+	}
+	m_unackedCommands.erase(m_unackedCommands.begin(), m_unackedCommands.begin() + numAckedCommands);
+
+	if (m_isAwaitingBarrierAck && sequence >= m_barrierSequence)
+	{
+		m_isAwaitingBarrierAck = false;
+	}
+}
+
+
+void NetProtocol::ResendUnackedCommands()
+{
+	for (int commandIndex = 0; commandIndex < m_unackedCommands.size(); commandIndex++)
+	{
+		QueueMessage(m_unackedCommands[commandIndex]);
+		m_numCommandsResent++;
+	}
+	m_barrierSendTime = GetCurrentTimeSeconds();
+}
+
+
+void NetProtocol::ResetLockstep()
+{
+	m_nextLocalSequence = 0;
+	m_nextRemoteSequence = 0;
+	ClearCommandHistory();
+}
+
+
+void NetProtocol::ClearCommandHistory()
+{
+	m_commandLog.clear();
+	m_recentStateDumps.clear();
+	m_unackedCommands.clear();
+	m_earlyRemoteCommands.clear();
+	m_isAwaitingBarrierAck = false;
+
+	m_hasDesynced = false;
+	if (m_desyncSnapshot != nullptr)
+	{
+		delete m_desyncSnapshot;
+		m_desyncSnapshot = nullptr;
+	}
+}
+
+
+//
+//desync functions
+//
+void NetProtocol::ReportDesync(NetMessage const& message)
+{
+	//everything after the first divergence diverges too, so only the first one is worth reporting
+	if (m_hasDesynced)
+	{
+		return;
+	}
+	m_hasDesynced = true;
+	m_desyncCommand = message;
+
+	int commandIndex = static_cast<int>(m_commandLog.size()) - 1;
+	Map const* map = g_theGame->m_currentMap;
+	g_theDevConsole->AddLine(DevConsole::COLOR_ERROR, Stringf("Desync at command %i (%s, sequence %u, player %i): local hash %016llx, remote hash %016llx", commandIndex,
+		GetCommandInfo(message.m_opcode)->m_name, message.m_sequence, message.m_playerID, static_cast<unsigned long long>(map->m_stateHash),
+		static_cast<unsigned long long>(message.m_stateHash)));
+
+	//our state is captured now, while it's still the state right after the offending command
+	m_desyncSnapshot = new MapSnapshot();
+	m_desyncSnapshot->Capture(*map, commandIndex);
+	SendCommand(NetOpcode::STATE_DUMP_REQUEST, commandIndex);
+}
+
+
+void NetProtocol::SendStateDump(int commandIndex)
+{
+	//our state as it was right after that command, or an empty dump if it's no longer kept, so the other player never diffs against a later state
+	NetMessage message;
+	message.m_opcode = NetOpcode::STATE_DUMP;
+	int oldestKeptIndex = static_cast<int>(m_commandLog.size()) - static_cast<int>(m_recentStateDumps.size());
+	if (commandIndex >= oldestKeptIndex && commandIndex < static_cast<int>(m_commandLog.size()))
+	{
+		g_theDevConsole->AddLine(DevConsole::COLOR_ERROR, Stringf("Other player desynced at command %i, sending them our state from then", commandIndex));
+		message.m_payload = m_recentStateDumps[commandIndex - oldestKeptIndex];
+	}
+	else
+	{
+		g_theDevConsole->AddLine(DevConsole::COLOR_ERROR, Stringf("Other player desynced at command %i, but our state from then is no longer kept", commandIndex));
+	}
+	QueueMessage(message);
+}
+
+
+void NetProtocol::ReceiveStateDump(std::string_view payload)
+{
+	if (m_desyncSnapshot == nullptr)
+	{
+		return;
+	}
+
+	//an empty dump means the other player no longer has its state from that command, and a diff against any other state would be misleading
+	MapSnapshot remoteSnapshot;
+	if (!payload.empty() && !remoteSnapshot.Deserialize(payload))
+	{
+		g_theDevConsole->AddLine(DevConsole::COLOR_ERROR, "Received malformed state dump!");
+		return;
+	}
+
+	std::vector<std::string> lines;
+	lines.emplace_back(Stringf("Desync at command %i: %s, sequence %u, from player %i", m_desyncSnapshot->m_commandIndex, GetCommandInfo(m_desyncCommand.m_opcode)->m_name,
+		m_desyncCommand.m_sequence, m_desyncCommand.m_playerID));
+	if (payload.empty() || remoteSnapshot.m_commandIndex != m_desyncSnapshot->m_commandIndex)
+	{
+		lines.emplace_back(Stringf(" No diff: the other player no longer has its state from command %i", m_desyncSnapshot->m_commandIndex));
+	}
+	else
+	{
+		m_desyncSnapshot->AppendDiff(remoteSnapshot, lines);
+	}
+
+	//the command log leading up to it, oldest first
+	lines.emplace_back(" Command log:");
+	for (int commandIndex = 0; commandIndex < m_commandLog.size() && commandIndex <= m_desyncSnapshot->m_commandIndex; commandIndex++)
+	{
+		NetMessage const& command = m_commandLog[commandIndex];
+		lines.emplace_back(Stringf("  %4i  %-20s player %i, tile %4i, sequence %u, hash %016llx", commandIndex, GetCommandInfo(command.m_opcode)->m_name, command.m_playerID, command.m_tileIndex,
+			command.m_sequence, static_cast<unsigned long long>(command.m_stateHash)));
+	}
+
+	std::ofstream file(NET_DESYNC_LOG_PATH);
+	for (int lineIndex = 0; lineIndex < lines.size(); lineIndex++)
+	{
+		g_theDevConsole->AddLine(lineIndex == 0 ? DevConsole::COLOR_ERROR : DevConsole::COLOR_INFO_MINOR, lines[lineIndex]);
+		file << lines[lineIndex] << "\n";
+	}
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, Stringf("Desync report written to %s", NET_DESYNC_LOG_PATH));
+
+	delete m_desyncSnapshot;
+	m_desyncSnapshot = nullptr;
+}
+
+
+//
+//resync functions
+//
+void NetProtocol::SendSnapshot()
+{
+	if (g_theGame == nullptr || g_theGame->m_currentMap == nullptr)
+	{
+		return;
+	}
+
+	//the snapshot already holds the effect of every command the other player may have missed, so there's nothing left to resend,
+	//and both sides start a fresh command log from it, so command indexes in desync reports mean the same command on both
+	ClearCommandHistory();
+
+	MapSnapshot snapshot;
+	snapshot.Capture(*g_theGame->m_currentMap, static_cast<int>(m_commandLog.size()) - 1);
+	snapshot.m_senderNextLocalSequence = m_nextLocalSequence;
+	snapshot.m_senderNextRemoteSequence = m_nextRemoteSequence;
+
+	std::string snapshotBytes;
+	snapshot.Serialize(snapshotBytes);
+
+	NetMessage message;
+	message.m_opcode = NetOpcode::STATE_SNAPSHOT;
+	message.m_payload = snapshotBytes;
+	QueueMessage(message);
+
+	m_numSnapshotsSent++;
+	m_lastSnapshotBytes = static_cast<int>(snapshotBytes.size());
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, Stringf("Sent a %i byte snapshot to bring the other player up to date", m_lastSnapshotBytes));
+}
+
+
+void NetProtocol::ReceiveSnapshot(std::string_view payload)
+{
+	if (g_theGame == nullptr || g_theGame->m_currentMap == nullptr)
+	{
+		return;
+	}
+
+	MapSnapshot snapshot;
+	if (!snapshot.Deserialize(payload) || !snapshot.Apply(*g_theGame->m_currentMap))
+	{
+		g_theDevConsole->AddLine(DevConsole::COLOR_ERROR, "Received a snapshot that doesn't fit this map!");
+		return;
+	}
+
+	//pick up both command streams where the sender left them, with the history they came from replaced by the snapshot, as the sender's was
+	m_nextLocalSequence = snapshot.m_senderNextRemoteSequence;
+	m_nextRemoteSequence = snapshot.m_senderNextLocalSequence;
+	ClearCommandHistory();
+
+	m_numSnapshotsReceived++;
+	m_lastSnapshotBytes = static_cast<int>(payload.size());
+	if (g_theGame->m_currentMap->m_stateHash != snapshot.m_stateHash)
+	{
+		g_theDevConsole->AddLine(DevConsole::COLOR_ERROR, "Applied snapshot, but its state hash doesn't match ours!");
+	}
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, Stringf("Resynchronized from a %i byte snapshot", m_lastSnapshotBytes));
+
+	//the other player is clearly there, so a rejoining player can go straight back into the match
+	g_theGame->m_remotePlayerReady = true;
+}
+
+
+//
+//benchmark functions
+//
+void NetProtocol::StartBenchmark(NetBenchmarkConfig const& config)
+{
+	if (m_benchmark != nullptr)
+	{
+		g_theDevConsole->AddLine(DevConsole::COLOR_ERROR, "A net benchmark is already running!");
+		return;
+	}
+
+	if (config.m_numMessages <= 0 && (config.m_messagesPerSecond <= 0.f || config.m_durationSeconds <= 0.0))
+	{
+		g_theDevConsole->AddLine(DevConsole::COLOR_ERROR, "A net benchmark needs a message count, or a rate and a duration");
+		return;
+	}
+
+	//a ping has to fit in one batch along with its opcode, sequence, and payload length
+	int maxPayloadBytes = static_cast<int>(m_maxBatchBytes) - NET_BENCHMARK_PING_OVERHEAD_BYTES;
+	if (config.m_payloadBytes > maxPayloadBytes)
+	{
+		g_theDevConsole->AddLine(DevConsole::COLOR_ERROR, Stringf("Net benchmark payloads can be at most %i bytes", maxPayloadBytes));
+		return;
+	}
+
+	m_numBenchmarkRuns++;
+	m_benchmark = new NetBenchmark(config, m_numBenchmarkRuns);
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, Stringf("Net benchmark %u started", m_numBenchmarkRuns));
+}
+
+
+//
+//command table functions
+//
+NetCommandInfo const* NetProtocol::GetCommandInfo(NetOpcode opcode)
+{
+	if (opcode == NetOpcode::INVALID || opcode >= NetOpcode::COUNT)
+	{
+		return nullptr;
+	}
+
+	return &s_netCommandTable[static_cast<int>(opcode)];
+}
+
+
+NetCommandInfo const* NetProtocol::GetCommandInfo(std::string_view name)
+{
+	for (int opcodeIndex = 1; opcodeIndex < static_cast<int>(NetOpcode::COUNT); opcodeIndex++)
+	{
+		if (name == s_netCommandTable[opcodeIndex].m_name)
+		{
+			return &s_netCommandTable[opcodeIndex];
+		}
+	}
+
+	return nullptr;
+}
+
+
+//
+//net commands
+//
+bool NetProtocol::Event_ReceiveBinaryCommands(EventArgs& args)
+{
+	if (g_theNetProtocol == nullptr)
+	{
+		return true;
+	}
+
+	std::string& bytes = g_theNetProtocol->m_receiveBytes;
+	if (!DecodeBase64Url(args.GetValue(NET_BINARY_DATA_NAME, ""), bytes) || !DispatchBatch(reinterpret_cast<unsigned char const*>(bytes.data()), bytes.size()))
+	{
+		g_theDevConsole->AddLine(DevConsole::COLOR_ERROR, "Received malformed binary net command!");
+	}
+
+	return true;
+}
+
+
+bool NetProtocol::Event_ReceiveLockstepCommand(EventArgs& args)
+{
+	if (g_theNetProtocol == nullptr)
+	{
+		return true;
+	}
+
+	NetMessage message;
+	message.m_opcode = static_cast<NetOpcode>(args.GetValue("Op", 0));
+	message.m_isSequenced = true;
+	message.m_sequence = static_cast<uint32_t>(args.GetValue("Seq", 0));
+	message.m_playerID = args.GetValue("Player", 0);
+	message.m_tileIndex = args.GetValue("Tile", -1);
+	message.m_value = args.GetValue("Value", 0);
+
+	std::string hashText = args.GetValue("Hash", "0");
+	std::from_chars(hashText.data(), hashText.data() + hashText.size(), message.m_stateHash);
+
+	if (GetCommandInfo(message.m_opcode) == nullptr)
+	{
+		g_theDevConsole->AddLine(DevConsole::COLOR_ERROR, "Received unknown lockstep net command!");
+		return true;
+	}
+
+	g_theNetProtocol->ReceiveLoggedCommand(message);
+	return true;
+}
+
+
+bool NetProtocol::Event_ReceivePayloadCommand(EventArgs& args)
+{
+	if (g_theNetProtocol == nullptr)
+	{
+		return true;
+	}
+
+	NetMessage message;
+	message.m_opcode = static_cast<NetOpcode>(args.GetValue("Op", 0));
+	message.m_value = args.GetValue("Value", 0);
+
+	std::string& bytes = g_theNetProtocol->m_receiveBytes;
+	if (GetCommandInfo(message.m_opcode) == nullptr || !DecodeBase64Url(args.GetValue(NET_BINARY_DATA_NAME, ""), bytes))
+	{
+		g_theDevConsole->AddLine(DevConsole::COLOR_ERROR, "Received malformed payload net command!");
+		return true;
+	}
+
+	message.m_payload = bytes;
+	DispatchNetMessage(message);
+	return true;
+}
+
+
+bool NetProtocol::Event_Resync(EventArgs& args)
+{
+	UNUSED(args);
+
+	if (g_theNetProtocol != nullptr)
+	{
+		g_theNetProtocol->SendSnapshot();
+	}
+
+	return true;
+}
+
+
+bool NetProtocol::Event_ProtocolBenchmark(EventArgs& args)
+{
+	int numMessages = args.GetValue("Count", NET_BENCHMARK_NUM_MESSAGES);
+
+	//a typical mix: mostly hover updates across the map, plus the turn commands
+	std::vector<NetMessage> messages;
+	messages.reserve(numMessages);
+	for (int messageIndex = 0; messageIndex < numMessages; messageIndex++)
+	{
+		NetMessage message;
+		if (messageIndex % 4 != 0)
+		{
+			message.m_opcode = NetOpcode::SELECT_HEX;
+			message.m_value = (messageIndex * 37) % 400 - 1;
+		}
+		else
+		{
+			message.m_opcode = static_cast<NetOpcode>(1 + (messageIndex / 4) % (static_cast<int>(NetOpcode::COUNT) - 1));
+			message.m_value = messageIndex % 100;
+		}
+		messages.emplace_back(message);
+	}
+
+	//encode both ways, counting the null terminator every net message carries
+	std::vector<std::string> textMessages;
+	textMessages.reserve(numMessages);
+	std::string binaryBytes;
+	std::string batchBytes;
+	size_t numTextBytes = 0;
+	size_t numWrappedBinaryBytes = 0;
+	size_t numBatchedBinaryBytes = 0;
+	for (int messageIndex = 0; messageIndex < numMessages; messageIndex++)
+	{
+		textMessages.emplace_back(FormatMessageAsText(messages[messageIndex]));
+		numTextBytes += textMessages.back().size() + 1;
+
+		size_t messageStart = binaryBytes.size();
+		EncodeMessage(messages[messageIndex], binaryBytes);
+		numWrappedBinaryBytes += NET_BINARY_COMMAND_OVERHEAD_BYTES + GetBase64UrlLength(binaryBytes.size() - messageStart);
+
+		AppendFramedMessage(messages[messageIndex], batchBytes);
+		if ((messageIndex + 1) % NET_BENCHMARK_MESSAGES_PER_BATCH == 0 || messageIndex == numMessages - 1)
+		{
+			numBatchedBinaryBytes += NET_BINARY_COMMAND_OVERHEAD_BYTES + GetBase64UrlLength(batchBytes.size());
+			batchBytes.clear();
+		}
+	}
+
+	//decode every way: the way the console builds event args from text, text tokenized in place, and binary
+	int numEventArgsValues = 0;
+	double eventArgsStartTime = GetCurrentTimeSeconds();
+	for (int messageIndex = 0; messageIndex < numMessages; messageIndex++)
+	{
+		Strings tokens = SplitStringOnDelimiter(textMessages[messageIndex], ' ');
+		EventArgs eventArgs;
+		for (int tokenIndex = 1; tokenIndex < tokens.size(); tokenIndex++)
+		{
+			Strings keyAndValue = SplitStringOnDelimiter(tokens[tokenIndex], '=');
+			if (keyAndValue.size() == 2)
+			{
+				eventArgs.SetValue(keyAndValue[0], keyAndValue[1]);
+			}
+		}
+		numEventArgsValues += eventArgs.GetValue("TileIndex", 0) != 0;
+	}
+	double eventArgsSeconds = GetCurrentTimeSeconds() - eventArgsStartTime;
+
+	NetMessage decoded;
+	int numMismatches = 0;
+	double textStartTime = GetCurrentTimeSeconds();
+	for (int messageIndex = 0; messageIndex < numMessages; messageIndex++)
+	{
+		ParseMessageFromText(textMessages[messageIndex], decoded);
+		numMismatches += decoded.m_opcode != messages[messageIndex].m_opcode;
+	}
+	double textSeconds = GetCurrentTimeSeconds() - textStartTime;
+
+	unsigned char const* data = reinterpret_cast<unsigned char const*>(binaryBytes.data());
+	size_t offset = 0;
+	double binaryStartTime = GetCurrentTimeSeconds();
+	for (int messageIndex = 0; messageIndex < numMessages; messageIndex++)
+	{
+		DecodeMessage(data, binaryBytes.size(), offset, decoded);
+		numMismatches += decoded.m_opcode != messages[messageIndex].m_opcode || decoded.m_value != messages[messageIndex].m_value;
+	}
+	double binarySeconds = GetCurrentTimeSeconds() - binaryStartTime;
+
+	float messageCount = static_cast<float>(numMessages);
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MAJOR, Stringf("Net protocol benchmark, %i messages:", numMessages));
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, Stringf(" Text:   %.2f bytes/msg, %.1f ns/msg into EventArgs, %.1f ns/msg tokenized in place", numTextBytes / messageCount,
+		eventArgsSeconds * 1.0e9 / messageCount, textSeconds * 1.0e9 / messageCount));
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, Stringf(" Binary: %.2f bytes/msg raw, %.2f bytes/msg wrapped, %.1f ns/msg decode", binaryBytes.size() / messageCount,
+		numWrappedBinaryBytes / messageCount, binarySeconds * 1.0e9 / messageCount));
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, Stringf(" Batched: %.2f bytes/msg wrapped, %i messages per batch", numBatchedBinaryBytes / messageCount, NET_BENCHMARK_MESSAGES_PER_BATCH));
+	if (numMismatches > 0)
+	{
+		g_theDevConsole->AddLine(DevConsole::COLOR_ERROR, Stringf(" %i messages did not round trip!", numMismatches));
+	}
+
+	return true;
+}
+
+
+bool NetProtocol::Event_PrintStats(EventArgs& args)
+{
+	UNUSED(args);
+
+	if (g_theNetProtocol == nullptr)
+	{
+		return true;
+	}
+
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MAJOR, "Net stats:");
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, Stringf(" Sent:       %i messages in %i batches, %i bytes", g_theNetProtocol->m_numMessagesSent, g_theNetProtocol->m_numBatchesSent,
+		g_theNetProtocol->m_numBytesSent));
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, Stringf(" Suppressed: %i messages, %i bytes saved", g_theNetProtocol->m_numMessagesSuppressed, g_theNetProtocol->m_numBytesSaved));
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, Stringf(" Cosmetic:   %i messages replaced by a newer value before sending", g_theNetProtocol->m_numCosmeticMessagesReplaced));
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, Stringf(" Lockstep:   %s, %i commands logged, %i unacked, %i resent, %i rejected%s", g_theNetProtocol->m_isLockstepEnabled ? "on" : "off",
+		static_cast<int>(g_theNetProtocol->m_commandLog.size()), static_cast<int>(g_theNetProtocol->m_unackedCommands.size()), g_theNetProtocol->m_numCommandsResent,
+		g_theNetProtocol->m_numCommandsRejected, g_theNetProtocol->m_isAwaitingBarrierAck ? ", waiting on turn end ack" : ""));
+
+	g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, Stringf(" Snapshots:  %i sent, %i received, last one %i bytes", g_theNetProtocol->m_numSnapshotsSent,
+		g_theNetProtocol->m_numSnapshotsReceived, g_theNetProtocol->m_lastSnapshotBytes));
+
+	//a full recompute that disagrees with the incremental hash means some state change skipped the map's setters
+	if (g_theGame != nullptr && g_theGame->m_currentMap != nullptr)
+	{
+		Map const* map = g_theGame->m_currentMap;
+		uint64_t recomputedHash = map->ComputeStateHash();
+		g_theDevConsole->AddLine(recomputedHash == map->m_stateHash ? DevConsole::COLOR_INFO_MINOR : DevConsole::COLOR_ERROR, Stringf(" State hash: %016llx, recomputed %016llx%s",
+			static_cast<unsigned long long>(map->m_stateHash), static_cast<unsigned long long>(recomputedHash), g_theNetProtocol->m_hasDesynced ? ", desynced" : ""));
+	}
+
+	NetUdpTransport const* udpTransport = g_theNetProtocol->m_udpTransport;
+	if (udpTransport != nullptr)
+	{
+		g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, Stringf(" UDP:        %i packets sent, %i received, %i resent, %i bytes, %i peers replaced", udpTransport->m_numPacketsSent.load(),
+			udpTransport->m_numPacketsReceived.load(), udpTransport->m_numPacketsResent.load(), udpTransport->m_numBytesSent.load(), udpTransport->m_numPeersReplaced.load()));
+		g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, Stringf(" Round trip: %.1fms smoothed, resending after %.1fms", 1000.0 * udpTransport->m_smoothedRoundTripSeconds.load(),
+			1000.0 * udpTransport->m_resendTimeoutSeconds.load()));
+
+		NetConditioner const& conditioner = udpTransport->m_conditioner;
+		if (conditioner.IsEnabled())
+		{
+			NetConditionerConfig const& simConfig = conditioner.m_config;
+			g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, Stringf(" Simulated:  %.0fms +/- %.0fms, %.1f%% loss, %.1f%% duplicated, %.1f%% reordered, %i kbps cap",
+				1000.0 * simConfig.m_latencySeconds, 1000.0 * simConfig.m_jitterSeconds, 100.f * simConfig.m_lossChance, 100.f * simConfig.m_duplicateChance,
+				100.f * simConfig.m_reorderChance, simConfig.m_bandwidthBytesPerSecond * 8 / 1000));
+			g_theDevConsole->AddLine(DevConsole::COLOR_INFO_MINOR, Stringf("             %i dropped, %i duplicated, %i reordered, %i dropped by a full link", conditioner.m_numDatagramsDropped.load(),
+				conditioner.m_numDatagramsDuplicated.load(), conditioner.m_numDatagramsReordered.load(), conditioner.m_numDatagramsOverflowed.load()));
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,252 @@
+#pragma once
+#include "Game/GameCommon.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+class NetBenchmark;
+class NetUdpTransport;
+struct MapSnapshot;
+struct NetBenchmarkConfig;
+
+
+constexpr int NET_MAX_COMMAND_ARGS = 4;
+constexpr unsigned char NET_OPCODE_SEQUENCED_FLAG = 0x80;
+constexpr unsigned char NET_OPCODE_PAYLOAD_FLAG = 0x40;
+
+
+//one byte opcodes for every command sent between players, in the same order as the command table
+enum class NetOpcode : unsigned char
+{
+	INVALID,
+	START_TURN,
+	SELECT_HEX,
+	SELECT_UNIT,
+	SELECT_FIRST_UNIT,
+	SELECT_LAST_UNIT,
+	SELECT_PREVIOUS_UNIT,
+	SELECT_NEXT_UNIT,
+	MOVE_UNIT,
+	CONFIRM_MOVE,
+	ATTACK,
+	CONFIRM_ATTACK,
+	CANCEL_MOVE,
+	END_TURN,
+	CONFIRM_END,
+	CANCEL_END,
+	REMOTE_PLAYER_READY,
+	OTHER_PLAYER_QUIT,
+	LOCKSTEP_BARRIER_ACK,
+	STATE_DUMP_REQUEST,
+	STATE_DUMP,
+	STATE_SNAPSHOT,
+	BENCHMARK_PING,
+	BENCHMARK_PONG,
+	ECHO,
+	COUNT
+};
+
+
+//authoritative commands change game state and always go out in order; cosmetic ones only need their latest value to arrive eventually
+enum class NetChannel
+{
+	AUTHORITATIVE,
+	COSMETIC
+};
+
+
+enum class NetProtocolMode
+{
+	TEXT,
+	BINARY
+};
+
+
+//TCP goes through the engine's net system as console commands, UDP goes out as raw datagrams from the game's own socket
+enum class NetTransport
+{
+	TCP,
+	UDP
+};
+
+
+//match commands in lockstep mode are sequenced, stamped with the acting player, and carry the tile they act on,
+//so applying one never depends on hover updates that may have been throttled or dropped
+//they also carry the sender's state hash after applying them, so the receiver can tell the moment the two states diverge
+struct NetMessage
+{
+	NetOpcode m_opcode = NetOpcode::INVALID;
+	int		  m_value = 0;
+
+	bool	 m_isSequenced = false;
+	uint32_t m_sequence = 0;
+	int		 m_playerID = 0;
+	int		 m_tileIndex = -1;
+	uint64_t m_stateHash = 0;
+
+	//raw bytes for the few messages that need more than one value, pointing into whatever buffer the message was built or decoded from
+	std::string_view m_payload;
+};
+
+
+//fixed-capacity stand-in for EventArgs on the receive path, so parsing and dispatching a command never allocates
+//names point into the received text or the command table, so the args can't outlive either
+struct NetCommandArgs
+{
+	bool SetValue(std::string_view name, int value);
+	int	 GetValue(std::string_view name, int defaultValue) const;
+
+	std::string_view m_names[NET_MAX_COMMAND_ARGS];
+	int				 m_values[NET_MAX_COMMAND_ARGS] = {};
+	int				 m_numArgs = 0;
+	std::string_view m_payload;
+};
+
+
+typedef void (*NetCommandHandler)(NetCommandArgs const& args);
+
+
+//varint helpers, shared with anything else that writes its own bytes to the wire
+void	 AppendVarint(std::string& bytes, uint32_t value);
+bool	 ReadVarint(unsigned char const* bytes, size_t numBytes, size_t& inoutOffset, uint32_t& outValue);
+int		 GetVarintSize(uint32_t value);
+uint32_t ZigZagEncode(int value);
+int		 ZigZagDecode(uint32_t value);
+
+
+//how each opcode maps to its text command, its single optional argument, the handler it dispatches to, the channel it travels on,
+//and whether it's a match command that goes through the lockstep command log
+struct NetCommandInfo
+{
+	NetOpcode		  m_opcode = NetOpcode::INVALID;
+	char const*		  m_name = nullptr;
+	char const*		  m_valueName = nullptr;
+	NetCommandHandler m_handler = nullptr;
+	NetChannel		  m_channel = NetChannel::AUTHORITATIVE;
+	bool			  m_isLogged = false;
+};
+
+
+class NetProtocol
+{
+//public member functions
+public:
+	//constructor and destructor
+	NetProtocol(NetProtocolMode mode, NetTransport transport);
+	NetProtocol(NetProtocol const& copy) = delete;
+	~NetProtocol();
+
+	//game flow functions
+	void BeginFrame();
+	void EndFrame();
+
+	//sending functions
+	void SendCommand(NetOpcode opcode, int value = 0);
+	void QueueMessage(NetMessage const& message);
+	void QueueCosmeticMessage(NetMessage const& message);
+	void FlushSendBatch();
+	void RecordSuppressedCommand(NetOpcode opcode, int value = 0);
+	int	 GetCommandWireBytes(NetOpcode opcode, int value) const;
+
+	//encoding functions
+	static void		   EncodeMessage(NetMessage const& message, std::string& outBytes);
+	static bool		   DecodeMessage(unsigned char const* bytes, size_t numBytes, size_t& inoutOffset, NetMessage& outMessage);
+	static void		   AppendFramedMessage(NetMessage const& message, std::string& outBatch);
+	static bool		   DispatchBatch(unsigned char const* bytes, size_t numBytes);
+	static std::string FormatMessageAsText(NetMessage const& message);
+	static bool		   ParseCommandText(std::string_view text, NetCommandInfo const*& outInfo, NetCommandArgs& outArgs);
+	static bool		   ParseMessageFromText(std::string_view text, NetMessage& outMessage);
+	static void		   DispatchNetMessage(NetMessage const& message);
+
+	//lockstep functions
+	void IssueCommand(NetOpcode opcode);
+	bool ApplyCommand(NetMessage const& message);
+	void ReceiveLoggedCommand(NetMessage const& message);
+	void ReceiveBarrierAck(uint32_t sequence);
+	void ResendUnackedCommands();
+	void ResetLockstep();
+	void ClearCommandHistory();
+
+	//desync functions
+	void ReportDesync(NetMessage const& message);
+	void SendStateDump(int commandIndex);
+	void ReceiveStateDump(std::string_view payload);
+
+	//resync functions
+	void SendSnapshot();
+	void ReceiveSnapshot(std::string_view payload);
+
+	//benchmark functions
+	void StartBenchmark(NetBenchmarkConfig const& config);
+
+	//command table functions
+	static NetCommandInfo const* GetCommandInfo(NetOpcode opcode);
+	static NetCommandInfo const* GetCommandInfo(std::string_view name);
+
+	//net commands
+	static bool Event_ReceiveBinaryCommands(EventArgs& args);
+	static bool Event_ReceiveLockstepCommand(EventArgs& args);
+	static bool Event_ReceivePayloadCommand(EventArgs& args);
+	static bool Event_ProtocolBenchmark(EventArgs& args);
+	static bool Event_PrintStats(EventArgs& args);
+	static bool Event_Resync(EventArgs& args);
+
+//public member variables
+public:
+	NetProtocolMode	 m_mode = NetProtocolMode::BINARY;
+	NetTransport	 m_transport = NetTransport::TCP;
+	NetUdpTransport* m_udpTransport = nullptr;
+
+	//everything sent in a frame goes out as one length-prefixed batch, split early only if it would overflow the net system's send buffer
+	std::string m_sendBatch;
+	size_t		m_maxBatchBytes = 0;
+	std::string m_receiveBytes;
+
+	//cosmetic messages wait here, one per opcode, and are held back while the net system's send queue is backed up
+	//over UDP they go out every frame as their own unreliable datagram instead
+	std::vector<NetMessage> m_pendingCosmeticMessages;
+	int						m_cosmeticBacklogLimit = 4;
+	bool					m_isSendQueueBackedUp = false;
+
+	//lockstep: every match command, local or remote, is applied through ApplyCommand in sequence order, and ending a turn
+	//is a barrier the other side has to ack before the commands leading up to it are dropped from the resend list
+	bool					m_isLockstepEnabled = true;
+	uint32_t				m_nextLocalSequence = 0;
+	uint32_t				m_nextRemoteSequence = 0;
+	std::vector<NetMessage> m_commandLog;
+	std::vector<NetMessage> m_unackedCommands;
+	std::vector<NetMessage> m_earlyRemoteCommands;
+	bool					m_isAwaitingBarrierAck = false;
+	uint32_t				m_barrierSequence = 0;
+	double					m_barrierSendTime = 0.0;
+	double					m_barrierTimeoutSeconds = 2.0;
+
+	//the first mismatched hash in a match asks the other player for their state, which is then diffed against ours as it was at that command
+	//the other player has usually applied more commands by the time the request arrives, so the state after each of the most recent
+	//commands is kept serialized, the last one matching the last command in the log
+	bool					m_hasDesynced = false;
+	NetMessage				m_desyncCommand;
+	MapSnapshot*			m_desyncSnapshot = nullptr;
+	std::deque<std::string> m_recentStateDumps;
+
+	//at most one round trip benchmark runs at a time, sending its pings at the end of each frame
+	NetBenchmark* m_benchmark = nullptr;
+	uint32_t	  m_numBenchmarkRuns = 0;
+
+	//stats
+	int m_numMessagesSent = 0;
+	int m_numBatchesSent = 0;
+	int m_numBytesSent = 0;
+	int m_numMessagesSuppressed = 0;
+	int m_numBytesSaved = 0;
+	int m_numCosmeticMessagesReplaced = 0;
+	int m_numCommandsResent = 0;
+	int m_numCommandsRejected = 0;
+	int m_numSnapshotsSent = 0;
+	int m_numSnapshotsReceived = 0;
+	int m_lastSnapshotBytes = 0;
+};
@@ -0,0 +1,718 @@
+#include "Game/NetUdpTransport.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+//Winsock on Windows, BSD sockets everywhere else, with the few calls that differ wrapped below
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <WinSock2.h>
+#include <WS2tcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+typedef int SocketAddressSize;
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+typedef int SOCKET;
+typedef socklen_t SocketAddressSize;
+constexpr SOCKET INVALID_SOCKET = -1;
+constexpr int SOCKET_ERROR = -1;
+#endif
+
+
+constexpr unsigned char UDP_FLAG_RELIABLE = 1 << 0;
+constexpr unsigned char UDP_FLAG_HAS_ACK = 1 << 1;
+
+//how strongly each new round trip sample pulls the smoothed time and its variation, the usual TCP gains
+constexpr double UDP_ROUND_TRIP_GAIN = 0.125;
+constexpr double UDP_ROUND_TRIP_VARIATION_GAIN = 0.25;
+
+
+//
+//platform functions
+//
+static int StartupSockets()
+{
+#if defined(_WIN32)
+	WSADATA wsaData;
+	return WSAStartup(MAKEWORD(2, 2), &wsaData);
+#else
+	return 0;
+#endif
+}
+
+
+static void ShutdownSockets()
+{
+#if defined(_WIN32)
+	WSACleanup();
+#endif
+}
+
+
+static int GetLastSocketError()
+{
+#if defined(_WIN32)
+	return WSAGetLastError();
+#else
+	return errno;
+#endif
+}
+
+
+//an unreachable peer shows up as a reset on Windows and a refusal elsewhere
+static bool IsPeerUnreachableError(int error)
+{
+#if defined(_WIN32)
+	return error == WSAECONNRESET;
+#else
+	return error == ECONNREFUSED;
+#endif
+}
+
+
+static void CloseSocket(SOCKET udpSocket)
+{
+#if defined(_WIN32)
+	closesocket(udpSocket);
+#else
+	close(udpSocket);
+#endif
+}
+
+
+static void SetSocketNonBlocking(SOCKET udpSocket)
+{
+#if defined(_WIN32)
+	u_long isNonBlocking = 1;
+	ioctlsocket(udpSocket, FIONBIO, &isNonBlocking);
+#else
+	fcntl(udpSocket, F_SETFL, fcntl(udpSocket, F_GETFL, 0) | O_NONBLOCK);
+#endif
+}
+
+
+//
+//payload functions
+//
+void UdpPayload::Assign(unsigned char const* bytes, int numBytes)
+{
+	m_numBytes = numBytes;
+	memcpy(m_bytes, bytes, numBytes);
+}
+
+
+std::string_view UdpPayload::GetBytes() const
+{
+	return std::string_view(reinterpret_cast<char const*>(m_bytes), m_numBytes);
+}
+
+
+//
+//helper functions
+//
+static bool IsSequenceNewer(uint16_t sequence, uint16_t comparedSequence)
+{
+	//sequences wrap, so anything less than half the range ahead counts as newer
+	return sequence != comparedSequence && static_cast<uint16_t>(sequence - comparedSequence) < 0x8000;
+}
+
+
+static void WriteUint16(unsigned char* bytes, uint16_t value)
+{
+	bytes[0] = static_cast<unsigned char>(value & 0xFF);
+	bytes[1] = static_cast<unsigned char>(value >> 8);
+}
+
+
+static void WriteUint32(unsigned char* bytes, uint32_t value)
+{
+	WriteUint16(bytes, static_cast<uint16_t>(value & 0xFFFF));
+	WriteUint16(bytes + 2, static_cast<uint16_t>(value >> 16));
+}
+
+
+static uint16_t ReadUint16(unsigned char const* bytes)
+{
+	return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+}
+
+
+static uint32_t ReadUint32(unsigned char const* bytes)
+{
+	return static_cast<uint32_t>(ReadUint16(bytes)) | (static_cast<uint32_t>(ReadUint16(bytes + 2)) << 16);
+}
+
+
+//
+//constructor
+//
+NetUdpTransport::NetUdpTransport(UdpTransportConfig const& config)
+	: m_config(config)
+	, m_resendTimeoutSeconds(std::max(UDP_INITIAL_RESEND_SECONDS, config.m_resendSeconds))
+	, m_conditioner(config.m_conditionerConfig)
+{
+}
+
+
+//
+//game flow functions
+//
+void NetUdpTransport::Startup()
+{
+	int result = StartupSockets();
+	GUARANTEE_OR_DIE(result == 0, Stringf("Failed to start sockets for UDP transport, error %i", result));
+
+	Strings addressSplit = SplitStringOnDelimiter(m_config.m_hostAddress, ':');
+	if (addressSplit.size() != 2)
+	{
+		ERROR_RECOVERABLE(Stringf("Invalid UDP host address %s, expected ip:port", m_config.m_hostAddress.c_str()));
+		return;
+	}
+
+	in_addr hostAddress = {};
+	if (inet_pton(AF_INET, addressSplit[0].c_str(), &hostAddress) != 1)
+	{
+		ERROR_RECOVERABLE(Stringf("Invalid UDP host ip %s", addressSplit[0].c_str()));
+		return;
+	}
+	uint16_t hostPort = static_cast<uint16_t>(atoi(addressSplit[1].c_str()));
+
+	SOCKET udpSocket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (udpSocket == INVALID_SOCKET)
+	{
+		ERROR_RECOVERABLE(Stringf("Failed to create UDP socket, error %i", GetLastSocketError()));
+		return;
+	}
+
+	//the server listens on the host port and learns the client's address from its first packet, the client lets the system pick a port
+	sockaddr_in bindAddress = {};
+	bindAddress.sin_family = AF_INET;
+	bindAddress.sin_addr.s_addr = htonl(INADDR_ANY);
+	bindAddress.sin_port = m_config.m_isServer ? htons(hostPort) : 0;
+	if (bind(udpSocket, reinterpret_cast<sockaddr*>(&bindAddress), sizeof(bindAddress)) == SOCKET_ERROR)
+	{
+		ERROR_RECOVERABLE(Stringf("Failed to bind UDP socket, error %i", GetLastSocketError()));
+		CloseSocket(udpSocket);
+		return;
+	}
+
+	SetSocketNonBlocking(udpSocket);
+	m_socket = static_cast<uintptr_t>(udpSocket);
+
+	if (!m_config.m_isServer)
+	{
+		m_remoteAddress = hostAddress.s_addr;
+		m_remotePort = htons(hostPort);
+		m_hasRemoteAddress = true;
+	}
+
+	m_isIOThreadRunning = true;
+	m_ioThread = std::thread(&NetUdpTransport::RunIOThread, this);
+}
+
+
+void NetUdpTransport::Shutdown()
+{
+	if (m_ioThread.joinable())
+	{
+		m_isIOThreadRunning = false;
+		m_ioThread.join();
+	}
+
+	if (m_socket != static_cast<uintptr_t>(INVALID_SOCKET))
+	{
+		CloseSocket(static_cast<SOCKET>(m_socket));
+		m_socket = static_cast<uintptr_t>(INVALID_SOCKET);
+	}
+	m_hasRemoteAddress = false;
+
+	ShutdownSockets();
+}
+
+
+void NetUdpTransport::BeginFrame()
+{
+	m_receivedPayloads.clear();
+
+	//popped straight into the next slot, so there's no temporary payload to copy through
+	m_receivedPayloads.emplace_back();
+	while (m_receiveQueue.Pop(m_receivedPayloads.back()))
+	{
+		m_receivedPayloads.emplace_back();
+	}
+	m_receivedPayloads.pop_back();
+}
+
+
+//
+//sending functions
+//
+void NetUdpTransport::SendUnreliable(std::string const& payload)
+{
+	if (payload.size() > UDP_MAX_PAYLOAD_BYTES)
+	{
+		ERROR_RECOVERABLE(Stringf("UDP payload of %i bytes is too large to send", static_cast<int>(payload.size())));
+		return;
+	}
+
+	//unreliable traffic is allowed to be dropped if the i/o thread has fallen this far behind
+	UdpOutgoingPayload outgoing;
+	outgoing.m_isReliable = false;
+	outgoing.m_payload = payload;
+	m_sendQueue.Push(std::move(outgoing));
+}
+
+
+void NetUdpTransport::SendReliable(std::string const& payload)
+{
+	if (payload.size() > UDP_MAX_PAYLOAD_BYTES)
+	{
+		ERROR_RECOVERABLE(Stringf("UDP payload of %i bytes is too large to send", static_cast<int>(payload.size())));
+		return;
+	}
+
+	UdpOutgoingPayload outgoing;
+	outgoing.m_isReliable = true;
+	outgoing.m_payload = payload;
+	if (!m_sendQueue.Push(std::move(outgoing)))
+	{
+		ERROR_RECOVERABLE("UDP send queue is full, the network thread has stopped keeping up");
+	}
+}
+
+
+//
+//query functions
+//
+bool NetUdpTransport::IsConnected() const
+{
+	return m_socket != static_cast<uintptr_t>(INVALID_SOCKET) && m_hasRemoteAddress;
+}
+
+
+//
+//i/o thread functions
+//
+void NetUdpTransport::RunIOThread()
+{
+	while (m_isIOThreadRunning)
+	{
+		WaitForDatagrams();
+		ReceiveDatagrams();
+		FlushUndeliveredPayloads();
+		SendQueuedPayloads();
+		ResendTimedOutPackets();
+		SendConditionedDatagrams();
+
+		//acks normally ride along on outgoing packets, so only send an empty one if there was nothing else to carry them,
+		//and keep a client that hasn't heard back yet announcing itself so the server learns its address
+		bool isAnnouncing = !m_config.m_isServer && m_numPacketsReceived == 0 && GetCurrentTimeSeconds() - m_lastSendTime >= m_config.m_resendSeconds;
+		if (m_isAckOwed || isAnnouncing)
+		{
+			SendDatagram(false, 0, "");
+		}
+	}
+}
+
+
+void NetUdpTransport::WaitForDatagrams()
+{
+	//sleep until something arrives, but wake regularly to pick up sends and resends
+	fd_set readSockets;
+	FD_ZERO(&readSockets);
+	FD_SET(static_cast<SOCKET>(m_socket), &readSockets);
+
+	timeval timeout = {};
+	timeout.tv_usec = UDP_IO_THREAD_WAIT_MICROSECONDS;
+	select(static_cast<int>(m_socket) + 1, &readSockets, nullptr, nullptr, &timeout);
+}
+
+
+void NetUdpTransport::SendQueuedPayloads()
+{
+	//reliable payloads held back by a full window go first, as acks open it up
+	while (!m_windowBlockedPayloads.empty() && !IsSendWindowFull())
+	{
+		SendReliablePayload(std::move(m_windowBlockedPayloads.front()));
+		m_windowBlockedPayloads.pop_front();
+	}
+
+	UdpOutgoingPayload outgoing;
+	while (m_sendQueue.Pop(outgoing))
+	{
+		if (!outgoing.m_isReliable)
+		{
+			SendDatagram(false, 0, outgoing.m_payload);
+		}
+		else if (!m_windowBlockedPayloads.empty() || IsSendWindowFull())
+		{
+			m_windowBlockedPayloads.emplace_back(std::move(outgoing.m_payload));
+		}
+		else
+		{
+			SendReliablePayload(std::move(outgoing.m_payload));
+		}
+	}
+}
+
+
+void NetUdpTransport::SendReliablePayload(std::string&& payload)
+{
+	//kept even if there's nobody to send to yet, so it goes out once the other side shows up
+	UdpSentPacket packet;
+	packet.m_sequence = m_nextSendSequence++;
+	packet.m_numSends = IsConnected() ? 1 : 0;
+	packet.m_firstSendTime = GetCurrentTimeSeconds();
+	packet.m_lastSendTime = packet.m_firstSendTime;
+	packet.m_payload = std::move(payload);
+	m_unackedPackets.emplace_back(std::move(packet));
+
+	UdpSentPacket const& sentPacket = m_unackedPackets.back();
+	SendDatagram(true, sentPacket.m_sequence, sentPacket.m_payload);
+}
+
+
+bool NetUdpTransport::IsSendWindowFull() const
+{
+	//counted from the oldest unacked packet, since the other side can't be missing anything older, and unacked packets stay in the order they were sent
+	if (m_unackedPackets.empty())
+	{
+		return false;
+	}
+
+	uint16_t numSequencesInFlight = static_cast<uint16_t>(m_nextSendSequence - m_unackedPackets.front().m_sequence);
+	return numSequencesInFlight >= UDP_MAX_SEQUENCES_IN_FLIGHT;
+}
+
+
+void NetUdpTransport::SendDatagram(bool isReliable, uint16_t sequence, std::string const& payload)
+{
+	if (!IsConnected())
+	{
+		return;
+	}
+
+	unsigned char datagram[UDP_MAX_DATAGRAM_BYTES];
+	datagram[0] = (isReliable ? UDP_FLAG_RELIABLE : 0) | (m_hasReceivedReliable ? UDP_FLAG_HAS_ACK : 0);
+	WriteUint16(datagram + 1, sequence);
+	WriteUint16(datagram + 3, m_newestReceivedSequence);
+	WriteUint32(datagram + 5, m_receivedAckBits);
+	memcpy(datagram + UDP_PACKET_HEADER_BYTES, payload.data(), payload.size());
+	int numBytes = UDP_PACKET_HEADER_BYTES + static_cast<int>(payload.size());
+
+	//counted as sent either way, so the conditioner's losses show up as resends just like real ones would
+	if (m_conditioner.IsEnabled())
+	{
+		m_conditioner.Submit(datagram, numBytes, m_remoteAddress, m_remotePort, GetCurrentTimeSeconds());
+	}
+	else
+	{
+		SendToAddress(datagram, numBytes, m_remoteAddress, m_remotePort);
+	}
+
+	m_numPacketsSent++;
+	m_numBytesSent += numBytes;
+	m_lastSendTime = GetCurrentTimeSeconds();
+	m_isAckOwed = false;
+}
+
+
+void NetUdpTransport::SendToAddress(unsigned char const* bytes, int numBytes, uint32_t address, uint16_t port)
+{
+	sockaddr_in remoteAddress = {};
+	remoteAddress.sin_family = AF_INET;
+	remoteAddress.sin_addr.s_addr = address;
+	remoteAddress.sin_port = port;
+	sendto(static_cast<SOCKET>(m_socket), reinterpret_cast<char const*>(bytes), numBytes, 0, reinterpret_cast<sockaddr const*>(&remoteAddress), sizeof(remoteAddress));
+}
+
+
+void NetUdpTransport::SendConditionedDatagrams()
+{
+	if (!m_conditioner.IsEnabled())
+	{
+		return;
+	}
+
+	//each delayed datagram keeps the address it was sent to, so ones still in flight when a peer is replaced go to the old peer
+	NetDelayedDatagram delayedDatagram;
+	double currentTime = GetCurrentTimeSeconds();
+	while (m_conditioner.PopReleased(currentTime, delayedDatagram))
+	{
+		SendToAddress(reinterpret_cast<unsigned char const*>(delayedDatagram.m_bytes.data()), static_cast<int>(delayedDatagram.m_bytes.size()), delayedDatagram.m_address, delayedDatagram.m_port);
+	}
+}
+
+
+void NetUdpTransport::ReceiveDatagrams()
+{
+	if (m_socket == static_cast<uintptr_t>(INVALID_SOCKET))
+	{
+		return;
+	}
+
+	unsigned char datagram[UDP_MAX_DATAGRAM_BYTES];
+	while (true)
+	{
+		sockaddr_in senderAddress = {};
+		SocketAddressSize senderAddressSize = sizeof(senderAddress);
+		int numBytes = recvfrom(static_cast<SOCKET>(m_socket), reinterpret_cast<char*>(datagram), UDP_MAX_DATAGRAM_BYTES, 0, reinterpret_cast<sockaddr*>(&senderAddress), &senderAddressSize);
+		if (numBytes == SOCKET_ERROR)
+		{
+			//an unreachable peer shows up as an error on the next receive, which just means nobody is listening yet
+			if (IsPeerUnreachableError(GetLastSocketError()))
+			{
+				continue;
+			}
+			return;
+		}
+
+		//the first peer to reach the server becomes its remote, and a new one after that is the other player rejoining from a fresh socket,
+		//whose sequence numbers start over, so the old peer's reliable state goes with it
+		bool isFromRemote = m_hasRemoteAddress && senderAddress.sin_addr.s_addr == m_remoteAddress && senderAddress.sin_port == m_remotePort;
+		if (!isFromRemote)
+		{
+			if (!m_config.m_isServer)
+			{
+				continue;
+			}
+
+			if (m_hasRemoteAddress)
+			{
+				ResetReliableState();
+				m_numPeersReplaced++;
+			}
+			m_remoteAddress = senderAddress.sin_addr.s_addr;
+			m_remotePort = senderAddress.sin_port;
+			m_hasRemoteAddress = true;
+		}
+
+		ProcessDatagram(datagram, numBytes);
+	}
+}
+
+
+void NetUdpTransport::ResetReliableState()
+{
+	m_nextSendSequence = 0;
+	m_unackedPackets.clear();
+	m_windowBlockedPayloads.clear();
+	m_hasRoundTripSample = false;
+	m_roundTripVariationSeconds = 0.0;
+	m_smoothedRoundTripSeconds = 0.0;
+	m_resendTimeoutSeconds = std::max(UDP_INITIAL_RESEND_SECONDS, m_config.m_resendSeconds);
+
+	m_nextDeliverySequence = 0;
+	for (int slotIndex = 0; slotIndex < UDP_RECEIVE_WINDOW_SIZE; slotIndex++)
+	{
+		m_receiveWindow[slotIndex].m_isReceived = false;
+	}
+	m_hasReceivedReliable = false;
+	m_newestReceivedSequence = 0;
+	m_receivedAckBits = 0;
+	m_isAckOwed = false;
+}
+
+
+void NetUdpTransport::ProcessDatagram(unsigned char const* bytes, int numBytes)
+{
+	if (numBytes < UDP_PACKET_HEADER_BYTES)
+	{
+		return;
+	}
+	m_numPacketsReceived++;
+
+	unsigned char flags = bytes[0];
+	uint16_t sequence = ReadUint16(bytes + 1);
+	if ((flags & UDP_FLAG_HAS_ACK) != 0)
+	{
+		ProcessAcks(ReadUint16(bytes + 3), ReadUint32(bytes + 5));
+	}
+
+	//payload bytes are only copied once they have somewhere to go: straight to the game thread for unreliable ones, or into the window for reliable ones
+	unsigned char const* payloadBytes = bytes + UDP_PACKET_HEADER_BYTES;
+	int numPayloadBytes = numBytes - UDP_PACKET_HEADER_BYTES;
+	if ((flags & UDP_FLAG_RELIABLE) == 0)
+	{
+		if (numPayloadBytes > 0)
+		{
+			m_unreliablePayload.Assign(payloadBytes, numPayloadBytes);
+			DeliverPayload(m_unreliablePayload);
+		}
+		return;
+	}
+
+	//a packet past the end of the window has nowhere to be held, so it isn't acked either, and the sender keeps resending it until it fits
+	bool isAlreadyDelivered = IsSequenceNewer(m_nextDeliverySequence, sequence);
+	uint16_t distanceAhead = static_cast<uint16_t>(sequence - m_nextDeliverySequence);
+	if (!isAlreadyDelivered && distanceAhead >= UDP_RECEIVE_WINDOW_SIZE)
+	{
+		return;
+	}
+
+	//everything else gets acked, even duplicates, since the ack for the first copy may be what was lost
+	RecordReceivedSequence(sequence);
+	m_isAckOwed = true;
+	if (isAlreadyDelivered)
+	{
+		return;
+	}
+
+	UdpReceivedPacket& slot = m_receiveWindow[sequence % UDP_RECEIVE_WINDOW_SIZE];
+	if (!slot.m_isReceived)
+	{
+		slot.m_isReceived = true;
+		slot.m_sequence = sequence;
+		slot.m_payload.Assign(payloadBytes, numPayloadBytes);
+	}
+
+	//deliver everything that's now contiguous
+	while (true)
+	{
+		UdpReceivedPacket& nextSlot = m_receiveWindow[m_nextDeliverySequence % UDP_RECEIVE_WINDOW_SIZE];
+		if (!nextSlot.m_isReceived || nextSlot.m_sequence != m_nextDeliverySequence)
+		{
+			break;
+		}
+
+		DeliverPayload(nextSlot.m_payload);
+		nextSlot.m_isReceived = false;
+		m_nextDeliverySequence++;
+	}
+}
+
+
+void NetUdpTransport::ProcessAcks(uint16_t ack, uint32_t ackBits)
+{
+	double currentTime = GetCurrentTimeSeconds();
+	auto isAcked = [this, ack, ackBits, currentTime](UdpSentPacket const& packet)
+	{
+		uint16_t distanceBehind = static_cast<uint16_t>(ack - packet.m_sequence);
+		if (distanceBehind != 0 && (distanceBehind > UDP_NUM_ACK_BITS || (ackBits & (1u << (distanceBehind - 1))) == 0))
+		{
+			return false;
+		}
+
+		if (packet.m_numSends == 1)
+		{
+			AddRoundTripSample(currentTime - packet.m_firstSendTime);
+		}
+		return true;
+	};
+	m_unackedPackets.erase(std::remove_if(m_unackedPackets.begin(), m_unackedPackets.end(), isAcked), m_unackedPackets.end());
+}
+
+
+void NetUdpTransport::RecordReceivedSequence(uint16_t sequence)
+{
+	//bit n of the ack bits means the packet n + 1 before the newest one has arrived
+	if (!m_hasReceivedReliable)
+	{
+		m_hasReceivedReliable = true;
+		m_newestReceivedSequence = sequence;
+		m_receivedAckBits = 0;
+	}
+	else if (IsSequenceNewer(sequence, m_newestReceivedSequence))
+	{
+		uint16_t shift = static_cast<uint16_t>(sequence - m_newestReceivedSequence);
+		m_receivedAckBits = shift >= UDP_NUM_ACK_BITS ? 0 : m_receivedAckBits << shift;
+		if (shift <= UDP_NUM_ACK_BITS)
+		{
+			m_receivedAckBits |= 1u << (shift - 1);
+		}
+		m_newestReceivedSequence = sequence;
+	}
+	else
+	{
+		uint16_t distanceBehind = static_cast<uint16_t>(m_newestReceivedSequence - sequence);
+		if (distanceBehind >= 1 && distanceBehind <= UDP_NUM_ACK_BITS)
+		{
+			m_receivedAckBits |= 1u << (distanceBehind - 1);
+		}
+	}
+}
+
+
+void NetUdpTransport::AddRoundTripSample(double roundTripSeconds)
+{
+	if (!m_hasRoundTripSample)
+	{
+		m_hasRoundTripSample = true;
+		m_smoothedRoundTripSeconds = roundTripSeconds;
+		m_roundTripVariationSeconds = 0.5 * roundTripSeconds;
+	}
+	else
+	{
+		double smoothedRoundTripSeconds = m_smoothedRoundTripSeconds;
+		m_roundTripVariationSeconds += UDP_ROUND_TRIP_VARIATION_GAIN * (fabs(roundTripSeconds - smoothedRoundTripSeconds) - m_roundTripVariationSeconds);
+		m_smoothedRoundTripSeconds = smoothedRoundTripSeconds + UDP_ROUND_TRIP_GAIN * (roundTripSeconds - smoothedRoundTripSeconds);
+	}
+
+	double resendTimeoutSeconds = m_smoothedRoundTripSeconds + 4.0 * m_roundTripVariationSeconds;
+	m_resendTimeoutSeconds = std::clamp(resendTimeoutSeconds, m_config.m_resendSeconds, std::max(UDP_MAX_RESEND_SECONDS, m_config.m_resendSeconds));
+}
+
+
+void NetUdpTransport::ResendTimedOutPackets()
+{
+	if (!IsConnected())
+	{
+		return;
+	}
+
+	//a packet queued before there was anyone to send it to goes out straight away
+	double currentTime = GetCurrentTimeSeconds();
+	double resendTimeoutSeconds = m_resendTimeoutSeconds;
+	bool hasTimedOutAgain = false;
+	for (int packetIndex = 0; packetIndex < m_unackedPackets.size(); packetIndex++)
+	{
+		UdpSentPacket& packet = m_unackedPackets[packetIndex];
+		if (packet.m_numSends > 0 && currentTime - packet.m_lastSendTime < resendTimeoutSeconds)
+		{
+			continue;
+		}
+
+		SendDatagram(true, packet.m_sequence, packet.m_payload);
+		packet.m_lastSendTime = currentTime;
+		if (packet.m_numSends > 0)
+		{
+			m_numPacketsResent++;
+		}
+		hasTimedOutAgain = hasTimedOutAgain || packet.m_numSends > 1;
+		packet.m_numSends++;
+	}
+
+	//one loss is just a loss, but the same packet timing out again means the timeout is too short for the link, and it backs off once per pass rather than once per packet
+	if (hasTimedOutAgain)
+	{
+		m_resendTimeoutSeconds = std::min(2.0 * resendTimeoutSeconds, std::max(UDP_MAX_RESEND_SECONDS, m_config.m_resendSeconds));
+	}
+}
+
+
+void NetUdpTransport::DeliverPayload(UdpPayload const& payload)
+{
+	//anything already waiting goes first, so reliable payloads stay in order
+	if (!m_undeliveredPayloads.empty() || !m_receiveQueue.Push(payload))
+	{
+		m_undeliveredPayloads.emplace_back(payload);
+	}
+}
+
+
+void NetUdpTransport::FlushUndeliveredPayloads()
+{
+	while (!m_undeliveredPayloads.empty() && m_receiveQueue.Push(m_undeliveredPayloads.front()))
+	{
+		m_undeliveredPayloads.pop_front();
+	}
+}
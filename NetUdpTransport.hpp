@@ -0,0 +1,184 @@
+#pragma once
+#include "Game/NetConditioner.hpp"
+#include "Game/SpscQueue.hpp"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+
+constexpr int UDP_MAX_DATAGRAM_BYTES = 1200;
+constexpr int UDP_PACKET_HEADER_BYTES = 9;
+constexpr int UDP_MAX_PAYLOAD_BYTES = UDP_MAX_DATAGRAM_BYTES - UDP_PACKET_HEADER_BYTES;
+constexpr int UDP_RECEIVE_WINDOW_SIZE = 256;
+constexpr int UDP_NUM_ACK_BITS = 32;
+
+//an ack can only name packets up to the ack bits behind the newest one received, so a sender with more than this in flight could have one
+//arrive and never hear that it did; this also keeps the sender well inside the receive window
+constexpr int UDP_MAX_SEQUENCES_IN_FLIGHT = UDP_NUM_ACK_BITS + 1;
+static_assert(UDP_MAX_SEQUENCES_IN_FLIGHT <= UDP_RECEIVE_WINDOW_SIZE, "The sender can't have more in flight than the receiver can hold");
+constexpr double UDP_INITIAL_RESEND_SECONDS = 1.0;
+constexpr double UDP_MAX_RESEND_SECONDS = 2.0;
+constexpr size_t UDP_PAYLOAD_QUEUE_CAPACITY = 1024;
+constexpr int UDP_IO_THREAD_WAIT_MICROSECONDS = 1000;
+
+
+struct UdpTransportConfig
+{
+	bool		m_isServer = false;
+	std::string m_hostAddress = "127.0.0.1:27015";
+
+	//the shortest the resend timeout gets, whatever the round trip estimate says
+	double m_resendSeconds = 0.1;
+
+	NetConditionerConfig m_conditionerConfig;
+};
+
+
+//a payload handed from the game thread to the I/O thread
+struct UdpOutgoingPayload
+{
+	bool		m_isReliable = false;
+	std::string m_payload;
+};
+
+
+//a received payload in a fixed buffer, so it can go through the receive window and over to the game thread without allocating
+struct UdpPayload
+{
+	int			  m_numBytes = 0;
+	unsigned char m_bytes[UDP_MAX_PAYLOAD_BYTES];
+
+	void			 Assign(unsigned char const* bytes, int numBytes);
+	std::string_view GetBytes() const;
+};
+
+
+//a reliable packet kept around until the other side acks it
+//only a packet sent exactly once gives a round trip sample, since an ack for a resent one could be answering either copy
+struct UdpSentPacket
+{
+	uint16_t	m_sequence = 0;
+	int			m_numSends = 0;
+	double		m_firstSendTime = 0.0;
+	double		m_lastSendTime = 0.0;
+	std::string m_payload;
+};
+
+
+//a reliable packet that arrived ahead of one still missing, held until it can be delivered in order
+struct UdpReceivedPacket
+{
+	bool	   m_isReceived = false;
+	uint16_t   m_sequence = 0;
+	UdpPayload m_payload;
+};
+
+
+//connectionless UDP transport: unreliable payloads go out as single datagrams, reliable ones are sequenced, acked, and resent,
+//so a lost reliable packet never holds up unreliable traffic the way one lost TCP segment holds up the whole stream
+//all socket work happens on its own I/O thread, so acks and resends keep flowing through slow frames;
+//the game thread only ever touches the two queues
+class NetUdpTransport
+{
+//public member functions
+public:
+	//constructor
+	explicit NetUdpTransport(UdpTransportConfig const& config);
+
+	//game flow functions
+	void Startup();
+	void Shutdown();
+	void BeginFrame();
+
+	//sending functions
+	void SendUnreliable(std::string const& payload);
+	void SendReliable(std::string const& payload);
+
+	//query functions
+	bool IsConnected() const;
+
+//private member functions
+private:
+	//i/o thread functions
+	void RunIOThread();
+	void WaitForDatagrams();
+	void SendQueuedPayloads();
+	void SendReliablePayload(std::string&& payload);
+	bool IsSendWindowFull() const;
+	void SendDatagram(bool isReliable, uint16_t sequence, std::string const& payload);
+	void SendToAddress(unsigned char const* bytes, int numBytes, uint32_t address, uint16_t port);
+	void SendConditionedDatagrams();
+	void ReceiveDatagrams();
+	void ResetReliableState();
+	void ProcessDatagram(unsigned char const* bytes, int numBytes);
+	void ProcessAcks(uint16_t ack, uint32_t ackBits);
+	void RecordReceivedSequence(uint16_t sequence);
+	void AddRoundTripSample(double roundTripSeconds);
+	void ResendTimedOutPackets();
+	void DeliverPayload(UdpPayload const& payload);
+	void FlushUndeliveredPayloads();
+
+//public member variables
+public:
+	UdpTransportConfig m_config;
+
+	//payloads drained at the start of this frame, unreliable ones as they arrived and reliable ones in sequence order
+	//cleared rather than freed every frame, so once it has grown to the busiest frame's traffic it stops allocating
+	std::vector<UdpPayload> m_receivedPayloads;
+
+	//stats, written by the i/o thread
+	std::atomic<int>	m_numPacketsSent = 0;
+	std::atomic<int>	m_numPacketsReceived = 0;
+	std::atomic<int>	m_numPacketsResent = 0;
+	std::atomic<int>	m_numBytesSent = 0;
+	std::atomic<int>	m_numPeersReplaced = 0;
+	std::atomic<double> m_smoothedRoundTripSeconds = 0.0;
+	std::atomic<double> m_resendTimeoutSeconds = 0.0;
+
+	//simulated network conditions on everything this side sends, owned by the i/o thread apart from its stats
+	NetConditioner m_conditioner;
+
+//private member variables
+private:
+	std::thread		  m_ioThread;
+	std::atomic<bool> m_isIOThreadRunning = false;
+
+	//game thread to i/o thread, and back
+	SpscQueue<UdpOutgoingPayload, UDP_PAYLOAD_QUEUE_CAPACITY> m_sendQueue;
+	SpscQueue<UdpPayload, UDP_PAYLOAD_QUEUE_CAPACITY>		  m_receiveQueue;
+
+	//everything below belongs to the i/o thread once it's running
+	uintptr_t		  m_socket = ~static_cast<uintptr_t>(0);
+	uint32_t		  m_remoteAddress = 0;
+	uint16_t		  m_remotePort = 0;
+	std::atomic<bool> m_hasRemoteAddress = false;
+
+	//reliable payloads already acked but not yet taken by the game thread, kept here rather than dropped if the receive queue is full
+	//the only part of the receive path that allocates, and only while the game thread is stalled
+	std::deque<UdpPayload> m_undeliveredPayloads;
+
+	//sending side
+	uint16_t				   m_nextSendSequence = 0;
+	std::vector<UdpSentPacket> m_unackedPackets;
+	std::deque<std::string>	   m_windowBlockedPayloads;
+	double					   m_lastSendTime = 0.0;
+
+	//the resend timeout is the smoothed round trip from the stats plus four times its variation, never below the configured resend time
+	//it starts out conservative so the first packets can give a sample before they're resent, and a packet timing out a second time doubles it
+	//until a fresh sample comes in, since that means the round trip has grown past the estimate
+	bool   m_hasRoundTripSample = false;
+	double m_roundTripVariationSeconds = 0.0;
+
+	//receiving side
+	uint16_t		  m_nextDeliverySequence = 0;
+	UdpReceivedPacket m_receiveWindow[UDP_RECEIVE_WINDOW_SIZE];
+	UdpPayload		  m_unreliablePayload;
+	bool			  m_hasReceivedReliable = false;
+	uint16_t		  m_newestReceivedSequence = 0;
+	uint32_t		  m_receivedAckBits = 0;
+	bool			  m_isAckOwed = false;
+};
@@ -0,0 +1,171 @@
+#include "Game/QuantizedMesh.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include <algorithm>
+#include <cmath>
+
+
+constexpr float UNORM16_MAX = 65535.0f;
+constexpr float SNORM16_MAX = 32767.0f;
+
+static_assert(sizeof(QuantizedVertex_PCUTBN) == 24, "Quantized model vertices should stay at 24 bytes");
+
+
+//
+//helper functions
+//
+static uint16_t QuantizeUnorm16(float value, float mins, float range)
+{
+	if (range <= 0.0f)
+	{
+		return 0;
+	}
+
+	float fraction = GetClamped((value - mins) / range, 0.0f, 1.0f);
+	return static_cast<uint16_t>(fraction * UNORM16_MAX + 0.5f);
+}
+
+
+static float DequantizeUnorm16(uint16_t value, float mins, float range)
+{
+	return mins + (static_cast<float>(value) / UNORM16_MAX) * range;
+}
+
+
+static int16_t QuantizeSnorm16(float value)
+{
+	return static_cast<int16_t>(roundf(GetClamped(value, -1.0f, 1.0f) * SNORM16_MAX));
+}
+
+
+static void EncodeOctahedral(Vec3 const& direction, int16_t* outEncoded)
+{
+	//project onto the octahedron, then fold the lower half over the upper so the whole sphere fits in a square
+	float manhattanLength = fabsf(direction.x) + fabsf(direction.y) + fabsf(direction.z);
+	if (manhattanLength <= 0.0f)
+	{
+		outEncoded[0] = 0;
+		outEncoded[1] = 0;
+		return;
+	}
+
+	float x = direction.x / manhattanLength;
+	float y = direction.y / manhattanLength;
+	if (direction.z < 0.0f)
+	{
+		float foldedX = (1.0f - fabsf(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+		float foldedY = (1.0f - fabsf(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+		x = foldedX;
+		y = foldedY;
+	}
+
+	outEncoded[0] = QuantizeSnorm16(x);
+	outEncoded[1] = QuantizeSnorm16(y);
+}
+
+
+static Vec3 DecodeOctahedral(int16_t const* encoded)
+{
+	float x = static_cast<float>(encoded[0]) / SNORM16_MAX;
+	float y = static_cast<float>(encoded[1]) / SNORM16_MAX;
+	float z = 1.0f - fabsf(x) - fabsf(y);
+
+	//unfold the lower half
+	float fold = std::max(-z, 0.0f);
+	x += x >= 0.0f ? -fold : fold;
+	y += y >= 0.0f ? -fold : fold;
+
+	Vec3 direction = Vec3(x, y, z);
+	float length = direction.GetLength();
+	return length > 0.0f ? direction / length : Vec3(0.0f, 0.0f, 1.0f);
+}
+
+
+//
+//encoding and decoding functions
+//
+void QuantizedMesh::Encode(std::vector<Vertex_PCUTBN> const& verts, std::vector<unsigned int> const& indexes)
+{
+	m_indexes = indexes;
+	m_verts.clear();
+	if (verts.empty())
+	{
+		return;
+	}
+
+	//bounds for positions and uvs, so the 16 bits cover only the range actually used
+	Vec3 positionMaxs = verts[0].m_position;
+	Vec2 uvMaxs = verts[0].m_uvTexCoords;
+	m_positionMins = verts[0].m_position;
+	m_uvMins = verts[0].m_uvTexCoords;
+	for (int vertIndex = 1; vertIndex < verts.size(); vertIndex++)
+	{
+		Vec3 const& position = verts[vertIndex].m_position;
+		Vec2 const& uv = verts[vertIndex].m_uvTexCoords;
+		m_positionMins = Vec3(std::min(m_positionMins.x, position.x), std::min(m_positionMins.y, position.y), std::min(m_positionMins.z, position.z));
+		positionMaxs = Vec3(std::max(positionMaxs.x, position.x), std::max(positionMaxs.y, position.y), std::max(positionMaxs.z, position.z));
+		m_uvMins = Vec2(std::min(m_uvMins.x, uv.x), std::min(m_uvMins.y, uv.y));
+		uvMaxs = Vec2(std::max(uvMaxs.x, uv.x), std::max(uvMaxs.y, uv.y));
+	}
+	m_positionRange = positionMaxs - m_positionMins;
+	m_uvRange = uvMaxs - m_uvMins;
+
+	m_verts.resize(verts.size());
+	for (int vertIndex = 0; vertIndex < verts.size(); vertIndex++)
+	{
+		Vertex_PCUTBN const& vert = verts[vertIndex];
+		QuantizedVertex_PCUTBN& quantized = m_verts[vertIndex];
+
+		quantized.m_position[0] = QuantizeUnorm16(vert.m_position.x, m_positionMins.x, m_positionRange.x);
+		quantized.m_position[1] = QuantizeUnorm16(vert.m_position.y, m_positionMins.y, m_positionRange.y);
+		quantized.m_position[2] = QuantizeUnorm16(vert.m_position.z, m_positionMins.z, m_positionRange.z);
+		EncodeOctahedral(vert.m_normal, quantized.m_normal);
+		EncodeOctahedral(vert.m_tangent, quantized.m_tangent);
+		quantized.m_bitangentSign = DotProduct3D(CrossProduct3D(vert.m_normal, vert.m_tangent), vert.m_bitangent) < 0.0f ? -1 : 1;
+		quantized.m_uvTexCoords[0] = QuantizeUnorm16(vert.m_uvTexCoords.x, m_uvMins.x, m_uvRange.x);
+		quantized.m_uvTexCoords[1] = QuantizeUnorm16(vert.m_uvTexCoords.y, m_uvMins.y, m_uvRange.y);
+		quantized.m_color = vert.m_color;
+	}
+}
+
+
+Vertex_PCUTBN QuantizedMesh::DecodeVertex(int vertIndex) const
+{
+	QuantizedVertex_PCUTBN const& quantized = m_verts[vertIndex];
+
+	Vertex_PCUTBN vert;
+	vert.m_position.x = DequantizeUnorm16(quantized.m_position[0], m_positionMins.x, m_positionRange.x);
+	vert.m_position.y = DequantizeUnorm16(quantized.m_position[1], m_positionMins.y, m_positionRange.y);
+	vert.m_position.z = DequantizeUnorm16(quantized.m_position[2], m_positionMins.z, m_positionRange.z);
+	vert.m_normal = DecodeOctahedral(quantized.m_normal);
+	vert.m_tangent = DecodeOctahedral(quantized.m_tangent);
+	vert.m_bitangent = CrossProduct3D(vert.m_normal, vert.m_tangent) * static_cast<float>(quantized.m_bitangentSign);
+	vert.m_uvTexCoords.x = DequantizeUnorm16(quantized.m_uvTexCoords[0], m_uvMins.x, m_uvRange.x);
+	vert.m_uvTexCoords.y = DequantizeUnorm16(quantized.m_uvTexCoords[1], m_uvMins.y, m_uvRange.y);
+	vert.m_color = quantized.m_color;
+	return vert;
+}
+
+
+void QuantizedMesh::DecodeVerts(std::vector<Vertex_PCUTBN>& outVerts) const
+{
+	outVerts.resize(m_verts.size());
+	for (int vertIndex = 0; vertIndex < m_verts.size(); vertIndex++)
+	{
+		outVerts[vertIndex] = DecodeVertex(vertIndex);
+	}
+}
+
+
+//
+//query functions
+//
+int QuantizedMesh::GetNumVerts() const
+{
+	return static_cast<int>(m_verts.size());
+}
+
+
+size_t QuantizedMesh::GetMemoryBytes() const
+{
+	return m_verts.size() * sizeof(QuantizedVertex_PCUTBN) + m_indexes.size() * sizeof(unsigned int);
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/Vertex_PCUTBN.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include <cstdint>
+#include <vector>
+
+
+//24 byte model vertex: positions and uvs are 16 bit fractions of the mesh's bounds, normals and tangents are octahedral-encoded,
+//and the bitangent is rebuilt from their cross product and a stored handedness sign
+struct QuantizedVertex_PCUTBN
+{
+	uint16_t m_position[3] = {};
+	int16_t	 m_bitangentSign = 1;
+	int16_t	 m_normal[2] = {};
+	int16_t	 m_tangent[2] = {};
+	uint16_t m_uvTexCoords[2] = {};
+	Rgba8	 m_color;
+};
+
+
+class QuantizedMesh
+{
+//public member functions
+public:
+	//encoding and decoding functions
+	void		  Encode(std::vector<Vertex_PCUTBN> const& verts, std::vector<unsigned int> const& indexes);
+	Vertex_PCUTBN DecodeVertex(int vertIndex) const;
+	void		  DecodeVerts(std::vector<Vertex_PCUTBN>& outVerts) const;
+
+	//query functions
+	int	   GetNumVerts() const;
+	size_t GetMemoryBytes() const;
+
+//public member variables
+public:
+	Vec3 m_positionMins;
+	Vec3 m_positionRange;
+	Vec2 m_uvMins;
+	Vec2 m_uvRange;
+
+	std::vector<QuantizedVertex_PCUTBN> m_verts;
+	std::vector<unsigned int>			m_indexes;
+};
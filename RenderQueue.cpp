@@ -0,0 +1,255 @@
+#include "Game/RenderQueue.hpp"
+#include <algorithm>
+
+
+//sort key layout, from most to least significant: pass, depth mode, rasterizer mode, shader, texture, submission order
+//passes that keep submission order move it up to just below the pass and shift the state down, so it only merges neighbors
+constexpr int SORT_KEY_PASS_SHIFT = 56;
+constexpr int SORT_KEY_DEPTH_SHIFT = 52;
+constexpr int SORT_KEY_RASTERIZER_SHIFT = 48;
+constexpr int SORT_KEY_SHADER_SHIFT = 32;
+constexpr int SORT_KEY_TEXTURE_SHIFT = 16;
+constexpr int SORT_KEY_ORDERED_SEQUENCE_SHIFT = 40;
+constexpr uint64_t SORT_KEY_SEQUENCE_MASK = 0xFFFF;
+
+
+static bool IsPassInSubmissionOrder(RenderPass pass)
+{
+	return pass == RenderPass::TILE_OVERLAYS || pass == RenderPass::UI_PANELS || pass == RenderPass::UI_TEXT;
+}
+
+
+//
+//submission functions
+//
+void RenderQueue::SubmitVertexArray(RenderPass pass, Shader* shader, Texture const* texture, DepthMode depthMode, int numVerts, Vertex_PCU const* verts)
+{
+	if (numVerts <= 0)
+	{
+		return;
+	}
+
+	DrawCommand command;
+	command.m_shader = shader;
+	command.m_texture = texture;
+	command.m_depthMode = depthMode;
+	command.m_verts = verts;
+	command.m_numVerts = numVerts;
+	AddCommand(pass, command);
+}
+
+
+void RenderQueue::SubmitIndexedBuffer(RenderPass pass, Shader* shader, Texture const* texture, DepthMode depthMode, VertexBuffer* vertexBuffer, IndexBuffer* indexBuffer, int numIndexes)
+{
+	if (numIndexes <= 0)
+	{
+		return;
+	}
+
+	DrawCommand command;
+	command.m_shader = shader;
+	command.m_texture = texture;
+	command.m_depthMode = depthMode;
+	command.m_vertexBuffer = vertexBuffer;
+	command.m_indexBuffer = indexBuffer;
+	command.m_numIndexes = numIndexes;
+	AddCommand(pass, command);
+}
+
+
+void RenderQueue::Flush()
+{
+	if (m_commands.empty())
+	{
+		return;
+	}
+
+	//count what source-order submission would have cost, for comparison
+	DrawCommand const* previousCommand = nullptr;
+	for (int commandIndex = 0; commandIndex < m_commands.size(); commandIndex++)
+	{
+		m_numUnsortedStateChanges += CountStateChanges(previousCommand, m_commands[commandIndex]);
+		previousCommand = &m_commands[commandIndex];
+	}
+
+	std::sort(m_commands.begin(), m_commands.end(), [](DrawCommand const& a, DrawCommand const& b) { return a.m_sortKey < b.m_sortKey; });
+
+	//everything submitted to the queue is already in world or screen space
+	g_theRenderer->SetModelConstants();
+
+	previousCommand = nullptr;
+	int commandIndex = 0;
+	while (commandIndex < m_commands.size())
+	{
+		DrawCommand const& command = m_commands[commandIndex];
+		m_numStateChanges += CountStateChanges(previousCommand, command);
+		BindChangedState(previousCommand, command);
+		previousCommand = &command;
+
+		if (command.m_vertexBuffer != nullptr)
+		{
+			g_theRenderer->DrawVertexBufferIndexed(command.m_vertexBuffer, command.m_indexBuffer, command.m_numIndexes);
+			m_numIssuedDraws++;
+			commandIndex++;
+			continue;
+		}
+
+		//merge the run of vertex arrays that share this state into one draw
+		uint64_t stateKey = GetStateKey(command);
+		int runEnd = commandIndex + 1;
+		while (runEnd < m_commands.size() && m_commands[runEnd].m_vertexBuffer == nullptr && GetStateKey(m_commands[runEnd]) == stateKey)
+		{
+			runEnd++;
+		}
+
+		if (runEnd - commandIndex == 1)
+		{
+			g_theRenderer->DrawVertexArray(command.m_numVerts, command.m_verts);
+		}
+		else
+		{
+			m_mergedVerts.clear();
+			for (int runIndex = commandIndex; runIndex < runEnd; runIndex++)
+			{
+				DrawCommand const& runCommand = m_commands[runIndex];
+				m_mergedVerts.insert(m_mergedVerts.end(), runCommand.m_verts, runCommand.m_verts + runCommand.m_numVerts);
+			}
+			g_theRenderer->DrawVertexArray(static_cast<int>(m_mergedVerts.size()), m_mergedVerts.data());
+		}
+
+		m_numIssuedDraws++;
+		commandIndex = runEnd;
+	}
+
+	m_commands.clear();
+}
+
+
+//
+//stats functions
+//
+void RenderQueue::ResetFrameStats()
+{
+	m_numSubmittedDraws = 0;
+	m_numIssuedDraws = 0;
+	m_numUnsortedStateChanges = 0;
+	m_numStateChanges = 0;
+}
+
+
+//
+//private functions
+//
+void RenderQueue::AddCommand(RenderPass pass, DrawCommand& command)
+{
+	uint64_t sequence = std::min(static_cast<uint64_t>(m_commands.size()), SORT_KEY_SEQUENCE_MASK);
+
+	uint64_t stateBits = (static_cast<uint64_t>(command.m_depthMode) << SORT_KEY_DEPTH_SHIFT) |
+		(static_cast<uint64_t>(command.m_rasterizerMode) << SORT_KEY_RASTERIZER_SHIFT) |
+		(static_cast<uint64_t>(GetShaderID(command.m_shader)) << SORT_KEY_SHADER_SHIFT) |
+		(static_cast<uint64_t>(GetTextureID(command.m_texture)) << SORT_KEY_TEXTURE_SHIFT);
+
+	command.m_sortKey = static_cast<uint64_t>(pass) << SORT_KEY_PASS_SHIFT;
+	if (IsPassInSubmissionOrder(pass))
+	{
+		command.m_sortKey |= (sequence << SORT_KEY_ORDERED_SEQUENCE_SHIFT) | (stateBits >> SORT_KEY_TEXTURE_SHIFT);
+	}
+	else
+	{
+		command.m_sortKey |= stateBits | sequence;
+	}
+
+	m_commands.emplace_back(command);
+	m_numSubmittedDraws++;
+}
+
+
+uint64_t RenderQueue::GetStateKey(DrawCommand const& command) const
+{
+	RenderPass pass = static_cast<RenderPass>(command.m_sortKey >> SORT_KEY_PASS_SHIFT);
+	if (IsPassInSubmissionOrder(pass))
+	{
+		return command.m_sortKey & ~(SORT_KEY_SEQUENCE_MASK << SORT_KEY_ORDERED_SEQUENCE_SHIFT);
+	}
+
+	return command.m_sortKey & ~SORT_KEY_SEQUENCE_MASK;
+}
+
+
+int RenderQueue::GetShaderID(Shader const* shader)
+{
+	//0 is reserved for the default shader
+	if (shader == nullptr)
+	{
+		return 0;
+	}
+
+	for (int shaderIndex = 0; shaderIndex < m_shaderIDs.size(); shaderIndex++)
+	{
+		if (m_shaderIDs[shaderIndex] == shader)
+		{
+			return shaderIndex + 1;
+		}
+	}
+
+	m_shaderIDs.emplace_back(shader);
+	return static_cast<int>(m_shaderIDs.size());
+}
+
+
+int RenderQueue::GetTextureID(Texture const* texture)
+{
+	//0 is reserved for no texture
+	if (texture == nullptr)
+	{
+		return 0;
+	}
+
+	for (int textureIndex = 0; textureIndex < m_textureIDs.size(); textureIndex++)
+	{
+		if (m_textureIDs[textureIndex] == texture)
+		{
+			return textureIndex + 1;
+		}
+	}
+
+	m_textureIDs.emplace_back(texture);
+	return static_cast<int>(m_textureIDs.size());
+}
+
+
+int RenderQueue::CountStateChanges(DrawCommand const* previous, DrawCommand const& current) const
+{
+	if (previous == nullptr)
+	{
+		return 4;
+	}
+
+	int numChanges = 0;
+	if (previous->m_shader != current.m_shader) numChanges++;
+	if (previous->m_texture != current.m_texture) numChanges++;
+	if (previous->m_depthMode != current.m_depthMode) numChanges++;
+	if (previous->m_rasterizerMode != current.m_rasterizerMode) numChanges++;
+	return numChanges;
+}
+
+
+void RenderQueue::BindChangedState(DrawCommand const* previous, DrawCommand const& current) const
+{
+	if (previous == nullptr || previous->m_shader != current.m_shader)
+	{
+		g_theRenderer->BindShader(current.m_shader);
+	}
+	if (previous == nullptr || previous->m_texture != current.m_texture)
+	{
+		g_theRenderer->BindTexture(current.m_texture);
+	}
+	if (previous == nullptr || previous->m_depthMode != current.m_depthMode)
+	{
+		g_theRenderer->SetDepthMode(current.m_depthMode);
+	}
+	if (previous == nullptr || previous->m_rasterizerMode != current.m_rasterizerMode)
+	{
+		g_theRenderer->SetRasterizerMode(current.m_rasterizerMode);
+	}
+}
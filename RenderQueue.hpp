@@ -0,0 +1,81 @@
+#pragma once
+#include "Game/GameCommon.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include <cstdint>
+
+
+//forward declarations
+class Shader;
+class Texture;
+class VertexBuffer;
+class IndexBuffer;
+
+
+//passes are drawn in this order; within the ground, tile, and unit passes draws are sorted by state to cut state changes,
+//while the blended overlay and UI passes keep submission order so later draws still paint over earlier ones
+enum class RenderPass : unsigned char
+{
+	GROUND,
+	TILES,
+	TILE_OVERLAYS,
+	UNITS,
+	UI_PANELS,
+	UI_TEXT
+};
+
+
+struct DrawCommand
+{
+	uint64_t		  m_sortKey = 0;
+
+	//state
+	Shader*			  m_shader = nullptr;
+	Texture const*	  m_texture = nullptr;
+	DepthMode		  m_depthMode = DepthMode::ENABLED;
+	RasterizerMode	  m_rasterizerMode = RasterizerMode::SOLID_CULL_BACK;
+
+	//geometry, either a vertex array that lives until the end of the frame or GPU buffers
+	Vertex_PCU const* m_verts = nullptr;
+	int				  m_numVerts = 0;
+	VertexBuffer*	  m_vertexBuffer = nullptr;
+	IndexBuffer*	  m_indexBuffer = nullptr;
+	int				  m_numIndexes = 0;
+};
+
+
+class RenderQueue
+{
+//public member functions
+public:
+	//submission functions, vertex arrays are held by pointer and have to stay alive until the queue is flushed
+	void SubmitVertexArray(RenderPass pass, Shader* shader, Texture const* texture, DepthMode depthMode, int numVerts, Vertex_PCU const* verts);
+	void SubmitIndexedBuffer(RenderPass pass, Shader* shader, Texture const* texture, DepthMode depthMode, VertexBuffer* vertexBuffer, IndexBuffer* indexBuffer, int numIndexes);
+	void Flush();
+
+	//stats functions
+	void ResetFrameStats();
+
+//public member variables
+public:
+	std::vector<DrawCommand> m_commands;
+	std::vector<Vertex_PCU>	 m_mergedVerts;
+
+	std::vector<Shader const*>	m_shaderIDs;
+	std::vector<Texture const*> m_textureIDs;
+
+	//per-frame stats
+	int m_numSubmittedDraws = 0;
+	int m_numIssuedDraws = 0;
+	int m_numUnsortedStateChanges = 0;
+	int m_numStateChanges = 0;
+
+//private member functions
+private:
+	void	 AddCommand(RenderPass pass, DrawCommand& command);
+	uint64_t GetStateKey(DrawCommand const& command) const;
+	int		 GetShaderID(Shader const* shader);
+	int		 GetTextureID(Texture const* texture);
+	int		 CountStateChanges(DrawCommand const* previous, DrawCommand const& current) const;
+	void	 BindChangedState(DrawCommand const* previous, DrawCommand const& current) const;
+};
@@ -0,0 +1,525 @@
+#include "Game/SoftwareRenderer.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <fstream>
+#include <thread>
+
+
+constexpr int TGA_HEADER_SIZE = 18;
+constexpr unsigned char TGA_UNCOMPRESSED_TRUE_COLOR = 2;
+constexpr unsigned char TGA_TOP_LEFT_ORIGIN_BIT = 0x20;
+constexpr float ORTHO_MIN_DEPTH = 0.01f;
+
+
+//
+//software texture functions
+//
+bool SoftwareTexture::LoadFromTGAFile(std::string const& filePath)
+{
+	std::ifstream file(filePath, std::ios::binary);
+	if (!file)
+	{
+		return false;
+	}
+
+	unsigned char header[TGA_HEADER_SIZE] = {};
+	file.read(reinterpret_cast<char*>(header), TGA_HEADER_SIZE);
+	int bitsPerPixel = header[16];
+	if (!file || header[1] != 0 || header[2] != TGA_UNCOMPRESSED_TRUE_COLOR || (bitsPerPixel != 24 && bitsPerPixel != 32))
+	{
+		ERROR_RECOVERABLE("Software textures only support uncompressed 24 or 32 bit TGA files!");
+		return false;
+	}
+
+	m_dimensions = IntVec2(header[12] | (header[13] << 8), header[14] | (header[15] << 8));
+	bool isTopLeftOrigin = (header[17] & TGA_TOP_LEFT_ORIGIN_BIT) != 0;
+	file.seekg(TGA_HEADER_SIZE + header[0]);
+
+	int bytesPerPixel = bitsPerPixel / 8;
+	std::vector<unsigned char> pixelBytes(m_dimensions.x * m_dimensions.y * bytesPerPixel);
+	file.read(reinterpret_cast<char*>(pixelBytes.data()), pixelBytes.size());
+	if (!file)
+	{
+		ERROR_RECOVERABLE("TGA file is shorter than its header says!");
+		return false;
+	}
+
+	//texels are stored bottom row first, to match uv space
+	m_texels.resize(m_dimensions.x * m_dimensions.y);
+	for (int rowIndex = 0; rowIndex < m_dimensions.y; rowIndex++)
+	{
+		int destinationRow = isTopLeftOrigin ? m_dimensions.y - 1 - rowIndex : rowIndex;
+		for (int columnIndex = 0; columnIndex < m_dimensions.x; columnIndex++)
+		{
+			unsigned char const* pixel = &pixelBytes[(rowIndex * m_dimensions.x + columnIndex) * bytesPerPixel];
+			unsigned char alpha = bytesPerPixel == 4 ? pixel[3] : 255;
+			m_texels[destinationRow * m_dimensions.x + columnIndex] = Rgba8(pixel[2], pixel[1], pixel[0], alpha);
+		}
+	}
+
+	return true;
+}
+
+
+Rgba8 SoftwareTexture::SampleNearest(Vec2 const& uv) const
+{
+	if (m_texels.empty())
+	{
+		return Rgba8();
+	}
+
+	//wrap, like the default sampler
+	float u = uv.x - floorf(uv.x);
+	float v = uv.y - floorf(uv.y);
+	int texelX = std::min(static_cast<int>(u * m_dimensions.x), m_dimensions.x - 1);
+	int texelY = std::min(static_cast<int>(v * m_dimensions.y), m_dimensions.y - 1);
+	return m_texels[texelY * m_dimensions.x + texelX];
+}
+
+
+//
+//constructor
+//
+SoftwareRenderer::SoftwareRenderer(IntVec2 const& dimensions, int numThreads)
+	: m_dimensions(dimensions)
+	, m_numThreads(numThreads)
+{
+	if (m_numThreads <= 0)
+	{
+		m_numThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+	}
+
+	m_colorBuffer.resize(m_dimensions.x * m_dimensions.y);
+	m_inverseDepthBuffer.resize(m_dimensions.x * m_dimensions.y);
+
+	m_binGridSize = IntVec2((m_dimensions.x + SOFTWARE_BIN_SIZE - 1) / SOFTWARE_BIN_SIZE, (m_dimensions.y + SOFTWARE_BIN_SIZE - 1) / SOFTWARE_BIN_SIZE);
+	m_binTriangleIndexes.resize(m_binGridSize.x * m_binGridSize.y);
+	m_aspect = static_cast<float>(m_dimensions.x) / static_cast<float>(m_dimensions.y);
+}
+
+
+//
+//frame functions
+//
+void SoftwareRenderer::BeginPerspectiveFrame(Vec3 const& cameraPosition, EulerAngles const& cameraOrientation, float fovDegrees, float nearClipDist, Rgba8 const& clearColor)
+{
+	m_isPerspective = true;
+	m_cameraPosition = cameraPosition;
+	cameraOrientation.GetAsVectors_XFwd_YLeft_ZUp(m_cameraForward, m_cameraLeft, m_cameraUp);
+	m_tanHalfFOV = TanDegrees(fovDegrees * 0.5f);
+	m_nearClipDist = nearClipDist;
+
+	std::fill(m_colorBuffer.begin(), m_colorBuffer.end(), clearColor);
+	std::fill(m_inverseDepthBuffer.begin(), m_inverseDepthBuffer.end(), 0.0f);
+	m_triangles.clear();
+	for (int binIndex = 0; binIndex < m_binTriangleIndexes.size(); binIndex++)
+	{
+		m_binTriangleIndexes[binIndex].clear();
+	}
+}
+
+
+void SoftwareRenderer::BeginOrthoFrame(Vec2 const& bottomLeft, Vec2 const& topRight, float cameraHeight, Rgba8 const& clearColor)
+{
+	m_isPerspective = false;
+	m_orthoBottomLeft = bottomLeft;
+	m_orthoTopRight = topRight;
+	m_orthoCameraHeight = cameraHeight;
+
+	std::fill(m_colorBuffer.begin(), m_colorBuffer.end(), clearColor);
+	std::fill(m_inverseDepthBuffer.begin(), m_inverseDepthBuffer.end(), 0.0f);
+	m_triangles.clear();
+	for (int binIndex = 0; binIndex < m_binTriangleIndexes.size(); binIndex++)
+	{
+		m_binTriangleIndexes[binIndex].clear();
+	}
+}
+
+
+void SoftwareRenderer::EndFrame()
+{
+	int numBins = static_cast<int>(m_binTriangleIndexes.size());
+	if (m_numThreads <= 1)
+	{
+		for (int binIndex = 0; binIndex < numBins; binIndex++)
+		{
+			RasterizeBin(binIndex);
+		}
+		return;
+	}
+
+	//bins own disjoint pixels, so workers just pull the next unclaimed bin until they run out
+	std::atomic<int> nextBinIndex = 0;
+	std::vector<std::thread> workers;
+	workers.reserve(m_numThreads);
+	for (int threadIndex = 0; threadIndex < m_numThreads; threadIndex++)
+	{
+		workers.emplace_back([this, &nextBinIndex, numBins]()
+			{
+				for (int binIndex = nextBinIndex++; binIndex < numBins; binIndex = nextBinIndex++)
+				{
+					RasterizeBin(binIndex);
+				}
+			});
+	}
+
+	for (int threadIndex = 0; threadIndex < workers.size(); threadIndex++)
+	{
+		workers[threadIndex].join();
+	}
+}
+
+
+//
+//draw functions
+//
+void SoftwareRenderer::SetLightConstants(Vec3 const& sunDirection, float sunIntensity, float ambientIntensity)
+{
+	m_sunDirection = sunDirection.GetNormalized();
+	m_sunIntensity = sunIntensity;
+	m_ambientIntensity = ambientIntensity;
+}
+
+
+void SoftwareRenderer::DrawVertexArray(int numVerts, Vertex_PCU const* verts, SoftwareTexture const* texture, DepthMode depthMode)
+{
+	for (int vertIndex = 0; vertIndex + 2 < numVerts; vertIndex += 3)
+	{
+		SoftwareViewVertex a = TransformVertex(verts[vertIndex].m_position, verts[vertIndex].m_color, verts[vertIndex].m_uvTexCoords, 1.0f);
+		SoftwareViewVertex b = TransformVertex(verts[vertIndex + 1].m_position, verts[vertIndex + 1].m_color, verts[vertIndex + 1].m_uvTexCoords, 1.0f);
+		SoftwareViewVertex c = TransformVertex(verts[vertIndex + 2].m_position, verts[vertIndex + 2].m_color, verts[vertIndex + 2].m_uvTexCoords, 1.0f);
+		AddTriangle(a, b, c, texture, depthMode);
+	}
+}
+
+
+void SoftwareRenderer::DrawIndexed(Vertex_PCU const* verts, unsigned int const* indexes, int numIndexes, SoftwareTexture const* texture, DepthMode depthMode)
+{
+	for (int indexIndex = 0; indexIndex + 2 < numIndexes; indexIndex += 3)
+	{
+		Vertex_PCU const& vertA = verts[indexes[indexIndex]];
+		Vertex_PCU const& vertB = verts[indexes[indexIndex + 1]];
+		Vertex_PCU const& vertC = verts[indexes[indexIndex + 2]];
+		SoftwareViewVertex a = TransformVertex(vertA.m_position, vertA.m_color, vertA.m_uvTexCoords, 1.0f);
+		SoftwareViewVertex b = TransformVertex(vertB.m_position, vertB.m_color, vertB.m_uvTexCoords, 1.0f);
+		SoftwareViewVertex c = TransformVertex(vertC.m_position, vertC.m_color, vertC.m_uvTexCoords, 1.0f);
+		AddTriangle(a, b, c, texture, depthMode);
+	}
+}
+
+
+void SoftwareRenderer::DrawIndexedLit(Vertex_PCUTBN const* verts, unsigned int const* indexes, int numIndexes, DepthMode depthMode)
+{
+	//same diffuse model as the unit shader: ambient plus sun, evaluated per vertex
+	SoftwareViewVertex viewVerts[3];
+	for (int indexIndex = 0; indexIndex + 2 < numIndexes; indexIndex += 3)
+	{
+		for (int cornerIndex = 0; cornerIndex < 3; cornerIndex++)
+		{
+			Vertex_PCUTBN const& vert = verts[indexes[indexIndex + cornerIndex]];
+			float sunFacing = std::max(0.0f, -DotProduct3D(vert.m_normal.GetNormalized(), m_sunDirection));
+			float lightIntensity = std::min(1.0f, m_ambientIntensity + m_sunIntensity * sunFacing);
+			viewVerts[cornerIndex] = TransformVertex(vert.m_position, vert.m_color, vert.m_uvTexCoords, lightIntensity);
+		}
+		AddTriangle(viewVerts[0], viewVerts[1], viewVerts[2], nullptr, depthMode);
+	}
+}
+
+
+//
+//output functions
+//
+bool SoftwareRenderer::SaveToTGAFile(std::string const& filePath) const
+{
+	std::ofstream file(filePath, std::ios::binary);
+	if (!file)
+	{
+		ERROR_RECOVERABLE("Couldn't open software render output file!");
+		return false;
+	}
+
+	unsigned char header[TGA_HEADER_SIZE] = {};
+	header[2] = TGA_UNCOMPRESSED_TRUE_COLOR;
+	header[12] = static_cast<unsigned char>(m_dimensions.x & 0xFF);
+	header[13] = static_cast<unsigned char>(m_dimensions.x >> 8);
+	header[14] = static_cast<unsigned char>(m_dimensions.y & 0xFF);
+	header[15] = static_cast<unsigned char>(m_dimensions.y >> 8);
+	header[16] = 32;
+	header[17] = 8;
+	file.write(reinterpret_cast<char const*>(header), TGA_HEADER_SIZE);
+
+	//the color buffer is already bottom row first, which is TGA's default origin
+	std::vector<unsigned char> pixelBytes(m_colorBuffer.size() * 4);
+	for (int pixelIndex = 0; pixelIndex < m_colorBuffer.size(); pixelIndex++)
+	{
+		Rgba8 const& color = m_colorBuffer[pixelIndex];
+		pixelBytes[pixelIndex * 4] = color.b;
+		pixelBytes[pixelIndex * 4 + 1] = color.g;
+		pixelBytes[pixelIndex * 4 + 2] = color.r;
+		pixelBytes[pixelIndex * 4 + 3] = color.a;
+	}
+	file.write(reinterpret_cast<char const*>(pixelBytes.data()), pixelBytes.size());
+
+	return static_cast<bool>(file);
+}
+
+
+//returns how many pixels differ from a reference image by more than the tolerance in any channel, or -1 if the reference can't be read or is a different size
+//the tolerance absorbs rounding differences between compilers, not real changes in what got drawn
+int SoftwareRenderer::CompareToTGAFile(std::string const& filePath, int channelTolerance) const
+{
+	SoftwareTexture reference;
+	if (!reference.LoadFromTGAFile(filePath) || reference.m_dimensions != m_dimensions)
+	{
+		return -1;
+	}
+
+	int numMismatchedPixels = 0;
+	for (int pixelIndex = 0; pixelIndex < m_colorBuffer.size(); pixelIndex++)
+	{
+		Rgba8 const& color = m_colorBuffer[pixelIndex];
+		Rgba8 const& referenceColor = reference.m_texels[pixelIndex];
+		int maxChannelDifference = std::max(std::max(abs(color.r - referenceColor.r), abs(color.g - referenceColor.g)),
+			std::max(abs(color.b - referenceColor.b), abs(color.a - referenceColor.a)));
+		if (maxChannelDifference > channelTolerance)
+		{
+			numMismatchedPixels++;
+		}
+	}
+
+	return numMismatchedPixels;
+}
+
+
+//
+//private functions
+//
+SoftwareViewVertex SoftwareRenderer::TransformVertex(Vec3 const& position, Rgba8 const& color, Vec2 const& uv, float lightIntensity) const
+{
+	SoftwareViewVertex viewVert;
+	if (m_isPerspective)
+	{
+		Vec3 displacement = position - m_cameraPosition;
+		viewVert.m_right = -DotProduct3D(displacement, m_cameraLeft);
+		viewVert.m_up = DotProduct3D(displacement, m_cameraUp);
+		viewVert.m_depth = DotProduct3D(displacement, m_cameraForward);
+	}
+	else
+	{
+		//looking straight down from the camera height, so higher geometry is closer and wins the depth test
+		viewVert.m_right = position.x;
+		viewVert.m_up = position.y;
+		viewVert.m_depth = std::max(m_orthoCameraHeight - position.z, ORTHO_MIN_DEPTH);
+	}
+
+	viewVert.m_color[0] = (color.r / 255.0f) * lightIntensity;
+	viewVert.m_color[1] = (color.g / 255.0f) * lightIntensity;
+	viewVert.m_color[2] = (color.b / 255.0f) * lightIntensity;
+	viewVert.m_color[3] = color.a / 255.0f;
+	viewVert.m_uv = uv;
+	return viewVert;
+}
+
+
+void SoftwareRenderer::AddTriangle(SoftwareViewVertex const& a, SoftwareViewVertex const& b, SoftwareViewVertex const& c, SoftwareTexture const* texture, DepthMode depthMode)
+{
+	SoftwareViewVertex const* corners[3] = { &a, &b, &c };
+
+	//clip against the near plane, which can turn the triangle into a quad
+	SoftwareViewVertex clippedVerts[4];
+	int numClippedVerts = 0;
+	for (int cornerIndex = 0; cornerIndex < 3; cornerIndex++)
+	{
+		SoftwareViewVertex const& current = *corners[cornerIndex];
+		SoftwareViewVertex const& next = *corners[(cornerIndex + 1) % 3];
+		bool isCurrentInside = !m_isPerspective || current.m_depth >= m_nearClipDist;
+		bool isNextInside = !m_isPerspective || next.m_depth >= m_nearClipDist;
+
+		if (isCurrentInside)
+		{
+			clippedVerts[numClippedVerts++] = current;
+		}
+
+		if (isCurrentInside != isNextInside)
+		{
+			float t = (m_nearClipDist - current.m_depth) / (next.m_depth - current.m_depth);
+			SoftwareViewVertex& clipped = clippedVerts[numClippedVerts++];
+			clipped.m_right = Interpolate(current.m_right, next.m_right, t);
+			clipped.m_up = Interpolate(current.m_up, next.m_up, t);
+			clipped.m_depth = m_nearClipDist;
+			for (int channel = 0; channel < 4; channel++)
+			{
+				clipped.m_color[channel] = Interpolate(current.m_color[channel], next.m_color[channel], t);
+			}
+			clipped.m_uv = Vec2(Interpolate(current.m_uv.x, next.m_uv.x, t), Interpolate(current.m_uv.y, next.m_uv.y, t));
+		}
+	}
+
+	if (numClippedVerts < 3)
+	{
+		return;
+	}
+
+	AddProjectedTriangle(clippedVerts, texture, depthMode);
+	if (numClippedVerts == 4)
+	{
+		SoftwareViewVertex secondTriangle[3] = { clippedVerts[0], clippedVerts[2], clippedVerts[3] };
+		AddProjectedTriangle(secondTriangle, texture, depthMode);
+	}
+}
+
+
+void SoftwareRenderer::AddProjectedTriangle(SoftwareViewVertex const* verts, SoftwareTexture const* texture, DepthMode depthMode)
+{
+	SoftwareTriangle triangle;
+	triangle.m_texture = texture;
+	triangle.m_depthMode = depthMode;
+	triangle.m_isPerspective = m_isPerspective;
+
+	float minX = static_cast<float>(m_dimensions.x);
+	float minY = static_cast<float>(m_dimensions.y);
+	float maxX = 0.0f;
+	float maxY = 0.0f;
+	for (int cornerIndex = 0; cornerIndex < 3; cornerIndex++)
+	{
+		SoftwareViewVertex const& vert = verts[cornerIndex];
+
+		float ndcX;
+		float ndcY;
+		if (m_isPerspective)
+		{
+			ndcX = vert.m_right / (vert.m_depth * m_tanHalfFOV * m_aspect);
+			ndcY = vert.m_up / (vert.m_depth * m_tanHalfFOV);
+		}
+		else
+		{
+			ndcX = RangeMap(vert.m_right, m_orthoBottomLeft.x, m_orthoTopRight.x, -1.0f, 1.0f);
+			ndcY = RangeMap(vert.m_up, m_orthoBottomLeft.y, m_orthoTopRight.y, -1.0f, 1.0f);
+		}
+
+		//ortho depth is already linear in screen space, so the corners keep it and their attributes as they are
+		float inverseDepth = 1.0f / vert.m_depth;
+		float attributeScale = m_isPerspective ? inverseDepth : 1.0f;
+		triangle.m_screenX[cornerIndex] = (ndcX * 0.5f + 0.5f) * m_dimensions.x;
+		triangle.m_screenY[cornerIndex] = (ndcY * 0.5f + 0.5f) * m_dimensions.y;
+		triangle.m_inverseDepth[cornerIndex] = m_isPerspective ? inverseDepth : vert.m_depth;
+		for (int channel = 0; channel < 4; channel++)
+		{
+			triangle.m_colorOverDepth[cornerIndex][channel] = vert.m_color[channel] * attributeScale;
+		}
+		triangle.m_uvOverDepth[cornerIndex] = vert.m_uv * attributeScale;
+
+		minX = std::min(minX, triangle.m_screenX[cornerIndex]);
+		minY = std::min(minY, triangle.m_screenY[cornerIndex]);
+		maxX = std::max(maxX, triangle.m_screenX[cornerIndex]);
+		maxY = std::max(maxY, triangle.m_screenY[cornerIndex]);
+	}
+
+	if (maxX < 0.0f || maxY < 0.0f || minX >= m_dimensions.x || minY >= m_dimensions.y)
+	{
+		return;
+	}
+
+	//bin by screen bounds; triangles are appended in submission order so each bin keeps draw order
+	int triangleIndex = static_cast<int>(m_triangles.size());
+	m_triangles.emplace_back(triangle);
+
+	int minBinX = std::max(0, static_cast<int>(minX) / SOFTWARE_BIN_SIZE);
+	int minBinY = std::max(0, static_cast<int>(minY) / SOFTWARE_BIN_SIZE);
+	int maxBinX = std::min(m_binGridSize.x - 1, static_cast<int>(maxX) / SOFTWARE_BIN_SIZE);
+	int maxBinY = std::min(m_binGridSize.y - 1, static_cast<int>(maxY) / SOFTWARE_BIN_SIZE);
+	for (int binY = minBinY; binY <= maxBinY; binY++)
+	{
+		for (int binX = minBinX; binX <= maxBinX; binX++)
+		{
+			m_binTriangleIndexes[binY * m_binGridSize.x + binX].emplace_back(triangleIndex);
+		}
+	}
+}
+
+
+void SoftwareRenderer::RasterizeBin(int binIndex)
+{
+	int binMinX = (binIndex % m_binGridSize.x) * SOFTWARE_BIN_SIZE;
+	int binMinY = (binIndex / m_binGridSize.x) * SOFTWARE_BIN_SIZE;
+	int binMaxX = std::min(binMinX + SOFTWARE_BIN_SIZE, m_dimensions.x) - 1;
+	int binMaxY = std::min(binMinY + SOFTWARE_BIN_SIZE, m_dimensions.y) - 1;
+
+	std::vector<int> const& triangleIndexes = m_binTriangleIndexes[binIndex];
+	for (int listIndex = 0; listIndex < triangleIndexes.size(); listIndex++)
+	{
+		SoftwareTriangle const& triangle = m_triangles[triangleIndexes[listIndex]];
+		float const* x = triangle.m_screenX;
+		float const* y = triangle.m_screenY;
+
+		float area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+		if (fabsf(area) < 0.000001f)
+		{
+			continue;
+		}
+		float inverseArea = 1.0f / area;
+
+		int minX = std::max(binMinX, static_cast<int>(floorf(std::min(x[0], std::min(x[1], x[2])))));
+		int minY = std::max(binMinY, static_cast<int>(floorf(std::min(y[0], std::min(y[1], y[2])))));
+		int maxX = std::min(binMaxX, static_cast<int>(ceilf(std::max(x[0], std::max(x[1], x[2])))));
+		int maxY = std::min(binMaxY, static_cast<int>(ceilf(std::max(y[0], std::max(y[1], y[2])))));
+
+		for (int pixelY = minY; pixelY <= maxY; pixelY++)
+		{
+			float sampleY = pixelY + 0.5f;
+			for (int pixelX = minX; pixelX <= maxX; pixelX++)
+			{
+				float sampleX = pixelX + 0.5f;
+
+				//barycentric weights from edge functions, normalized so either winding works
+				float weight0 = ((x[2] - x[1]) * (sampleY - y[1]) - (y[2] - y[1]) * (sampleX - x[1])) * inverseArea;
+				float weight1 = ((x[0] - x[2]) * (sampleY - y[2]) - (y[0] - y[2]) * (sampleX - x[2])) * inverseArea;
+				float weight2 = 1.0f - weight0 - weight1;
+				if (weight0 < 0.0f || weight1 < 0.0f || weight2 < 0.0f)
+				{
+					continue;
+				}
+
+				int pixelIndex = pixelY * m_dimensions.x + pixelX;
+				float interpolatedDepth = weight0 * triangle.m_inverseDepth[0] + weight1 * triangle.m_inverseDepth[1] + weight2 * triangle.m_inverseDepth[2];
+				float inverseDepth = triangle.m_isPerspective ? interpolatedDepth : 1.0f / interpolatedDepth;
+				if (triangle.m_depthMode == DepthMode::ENABLED)
+				{
+					if (inverseDepth <= m_inverseDepthBuffer[pixelIndex])
+					{
+						continue;
+					}
+					m_inverseDepthBuffer[pixelIndex] = inverseDepth;
+				}
+
+				float attributeScale = triangle.m_isPerspective ? 1.0f / inverseDepth : 1.0f;
+				float color[4];
+				for (int channel = 0; channel < 4; channel++)
+				{
+					color[channel] = (weight0 * triangle.m_colorOverDepth[0][channel] + weight1 * triangle.m_colorOverDepth[1][channel] +
+						weight2 * triangle.m_colorOverDepth[2][channel]) * attributeScale;
+				}
+
+				if (triangle.m_texture != nullptr)
+				{
+					Vec2 uv = (triangle.m_uvOverDepth[0] * weight0 + triangle.m_uvOverDepth[1] * weight1 + triangle.m_uvOverDepth[2] * weight2) * attributeScale;
+					Rgba8 texel = triangle.m_texture->SampleNearest(uv);
+					color[0] *= texel.r / 255.0f;
+					color[1] *= texel.g / 255.0f;
+					color[2] *= texel.b / 255.0f;
+					color[3] *= texel.a / 255.0f;
+				}
+
+				//alpha blend over what's already there, rounding to the nearest channel value
+				Rgba8& destination = m_colorBuffer[pixelIndex];
+				float alpha = GetClamped(color[3], 0.0f, 1.0f);
+				destination.r = static_cast<unsigned char>(Interpolate(destination.r, GetClamped(color[0], 0.0f, 1.0f) * 255.0f, alpha) + 0.5f);
+				destination.g = static_cast<unsigned char>(Interpolate(destination.g, GetClamped(color[1], 0.0f, 1.0f) * 255.0f, alpha) + 0.5f);
+				destination.b = static_cast<unsigned char>(Interpolate(destination.b, GetClamped(color[2], 0.0f, 1.0f) * 255.0f, alpha) + 0.5f);
+				destination.a = static_cast<unsigned char>(Interpolate(destination.a, 255.0f, alpha) + 0.5f);
+			}
+		}
+	}
+}
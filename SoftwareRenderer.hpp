@@ -0,0 +1,113 @@
+#pragma once
+#include "Game/GameCommon.hpp"
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Core/Vertex_PCUTBN.hpp"
+#include "Engine/Math/IntVec2.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+
+
+constexpr int SOFTWARE_BIN_SIZE = 64;
+
+
+//CPU-side texels, loaded from uncompressed TGA files since the GPU textures can't be read back
+struct SoftwareTexture
+{
+	IntVec2			   m_dimensions = IntVec2();
+	std::vector<Rgba8> m_texels;
+
+	bool  LoadFromTGAFile(std::string const& filePath);
+	Rgba8 SampleNearest(Vec2 const& uv) const;
+};
+
+
+//a vertex after lighting and view transformation, before projection
+struct SoftwareViewVertex
+{
+	float m_right = 0.0f;
+	float m_up = 0.0f;
+	float m_depth = 0.0f;
+	float m_color[4] = {};
+	Vec2  m_uv;
+};
+
+
+//a projected triangle, with attributes divided by depth for perspective-correct interpolation
+//ortho triangles interpolate depth and attributes linearly, so they store plain depth and undivided attributes
+struct SoftwareTriangle
+{
+	float				   m_screenX[3] = {};
+	float				   m_screenY[3] = {};
+	float				   m_inverseDepth[3] = {};	//depth for ortho triangles
+	float				   m_colorOverDepth[3][4] = {};
+	Vec2				   m_uvOverDepth[3];
+	SoftwareTexture const* m_texture = nullptr;
+	DepthMode			   m_depthMode = DepthMode::ENABLED;
+	bool				   m_isPerspective = true;
+};
+
+
+//renders the subset of the game's draws that have CPU-side geometry, for thumbnails on machines without a GPU
+class SoftwareRenderer
+{
+//public member functions
+public:
+	//constructor
+	explicit SoftwareRenderer(IntVec2 const& dimensions, int numThreads = 0);
+
+	//frame functions
+	void BeginPerspectiveFrame(Vec3 const& cameraPosition, EulerAngles const& cameraOrientation, float fovDegrees, float nearClipDist, Rgba8 const& clearColor);
+	void BeginOrthoFrame(Vec2 const& bottomLeft, Vec2 const& topRight, float cameraHeight, Rgba8 const& clearColor);
+	void EndFrame();
+
+	//draw functions
+	void SetLightConstants(Vec3 const& sunDirection, float sunIntensity, float ambientIntensity);
+	void DrawVertexArray(int numVerts, Vertex_PCU const* verts, SoftwareTexture const* texture, DepthMode depthMode);
+	void DrawIndexed(Vertex_PCU const* verts, unsigned int const* indexes, int numIndexes, SoftwareTexture const* texture, DepthMode depthMode);
+	void DrawIndexedLit(Vertex_PCUTBN const* verts, unsigned int const* indexes, int numIndexes, DepthMode depthMode);
+
+	//output functions
+	bool SaveToTGAFile(std::string const& filePath) const;
+	int  CompareToTGAFile(std::string const& filePath, int channelTolerance) const;
+
+//public member variables
+public:
+	IntVec2 m_dimensions = IntVec2();
+	int		m_numThreads = 1;
+
+	std::vector<Rgba8> m_colorBuffer;
+	std::vector<float> m_inverseDepthBuffer;
+
+	//camera
+	bool  m_isPerspective = true;
+	Vec3  m_cameraPosition;
+	Vec3  m_cameraForward;
+	Vec3  m_cameraLeft;
+	Vec3  m_cameraUp;
+	float m_tanHalfFOV = 1.0f;
+	float m_aspect = 1.0f;
+	float m_nearClipDist = 0.1f;
+	Vec2  m_orthoBottomLeft;
+	Vec2  m_orthoTopRight;
+	float m_orthoCameraHeight = 1.0f;
+
+	//lighting
+	Vec3  m_sunDirection = Vec3(0.0f, 0.0f, -1.0f);
+	float m_sunIntensity = 1.0f;
+	float m_ambientIntensity = 0.0f;
+
+	//triangles for the current frame and the bins they overlap, in submission order
+	std::vector<SoftwareTriangle> m_triangles;
+	IntVec2						  m_binGridSize = IntVec2();
+	std::vector<std::vector<int>> m_binTriangleIndexes;
+
+//private member functions
+private:
+	SoftwareViewVertex TransformVertex(Vec3 const& position, Rgba8 const& color, Vec2 const& uv, float lightIntensity) const;
+	void			   AddTriangle(SoftwareViewVertex const& a, SoftwareViewVertex const& b, SoftwareViewVertex const& c, SoftwareTexture const* texture, DepthMode depthMode);
+	void			   AddProjectedTriangle(SoftwareViewVertex const* verts, SoftwareTexture const* texture, DepthMode depthMode);
+	void			   RasterizeBin(int binIndex);
+};
@@ -0,0 +1,71 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+
+//fixed-capacity ring buffer for exactly one producer thread and one consumer thread, no locks and no allocation after construction
+//capacity must be a power of two, and one slot is always left empty to tell full from empty
+template <typename T, size_t CAPACITY>
+class SpscQueue
+{
+	static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+//public member functions
+public:
+	//producer functions
+	bool Push(T const& value)
+	{
+		size_t tail = m_tail.load(std::memory_order_relaxed);
+		size_t nextTail = (tail + 1) & (CAPACITY - 1);
+		if (nextTail == m_head.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+
+		m_slots[tail] = value;
+		m_tail.store(nextTail, std::memory_order_release);
+		return true;
+	}
+
+	bool Push(T&& value)
+	{
+		size_t tail = m_tail.load(std::memory_order_relaxed);
+		size_t nextTail = (tail + 1) & (CAPACITY - 1);
+		if (nextTail == m_head.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+
+		m_slots[tail] = std::move(value);
+		m_tail.store(nextTail, std::memory_order_release);
+		return true;
+	}
+
+	//consumer functions
+	bool Pop(T& outValue)
+	{
+		size_t head = m_head.load(std::memory_order_relaxed);
+		if (head == m_tail.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+
+		outValue = std::move(m_slots[head]);
+		m_head.store((head + 1) & (CAPACITY - 1), std::memory_order_release);
+		return true;
+	}
+
+	bool IsEmpty() const
+	{
+		return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+	}
+
+//private member variables
+private:
+	T m_slots[CAPACITY];
+
+	//kept on separate cache lines so the two threads don't fight over them
+	alignas(64) std::atomic<size_t> m_head = 0;
+	alignas(64) std::atomic<size_t> m_tail = 0;
+};
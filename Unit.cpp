@@ -1,43 +1,42 @@
-#include "Game/Unit.hpp"
-#include "Game/Model.hpp"
-#include "Game/Game.hpp"
-#include "Game/Tile.hpp"
-#include "Game/Map.hpp"
-#include "Game/GameCommon.hpp"
-#include "Engine/Renderer/Renderer.hpp"
-
-
-//constructor
-Unit::Unit(UnitDefinition const* definition, IntVec2 startCoords, int ownerID)
-	: m_definition(definition)
-	, m_coords(startCoords)
-	, m_ownerID(ownerID)
-{
-	m_currentHealth = m_definition->m_health;
-}
-
-
-//game flow functions
-void Unit::Render() const
-{
-	if (m_definition != nullptr && m_definition->m_model != nullptr)
-	{
-		Tile const& tile = g_theGame->m_currentMap->m_tiles[g_theGame->m_currentMap->GetTileIndex(m_coords)];
-		Vec3 position = tile.GetCenterPos();
-
-		EulerAngles orientation = EulerAngles();
-		Rgba8 color = Rgba8(150, 150, 255);
-		if (m_ownerID == 2)
-		{
-			//orientation = EulerAngles(180.0f, 0.0f, 0.0f);
-			color = Rgba8(255, 150, 150);
-		}
-
-		if (m_movedThisTurn)
-		{
-			color = Rgba8(150, 150, 150);
-		}
-
-		m_definition->m_model->RenderGPUMesh(g_theGame->m_sunDirection, g_theGame->m_sunIntensity, g_theGame->m_ambientIntensity, position, orientation, color);
-	}
-}
+#include "Game/Unit.hpp"
+#include "Game/Model.hpp"
+#include "Game/Game.hpp"
+#include "Game/Tile.hpp"
+#include "Game/Map.hpp"
+#include "Game/GameCommon.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+
+
+//constructor
+Unit::Unit(UnitDefinition const* definition, IntVec2 startCoords, int ownerID, int unitID)
+	: m_definition(definition)
+	, m_coords(startCoords)
+	, m_ownerID(ownerID)
+	, m_unitID(unitID)
+{
+	m_currentHealth = m_definition->m_health;
+}
+
+
+//rendering functions
+ModelInstance Unit::GetModelInstance(Map const& map) const
+{
+	Tile const& tile = map.m_tiles[map.GetTileIndex(m_coords)];
+	
+	ModelInstance instance;
+	instance.m_position = tile.GetCenterPos();
+	instance.m_orientation = EulerAngles();
+	instance.m_color = Rgba8(150, 150, 255);
+	if (m_ownerID == 2)
+	{
+		//instance.m_orientation = EulerAngles(180.0f, 0.0f, 0.0f);
+		instance.m_color = Rgba8(255, 150, 150);
+	}
+
+	if (m_movedThisTurn)
+	{
+		instance.m_color = Rgba8(150, 150, 150);
+	}
+
+	return instance;
+}
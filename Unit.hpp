@@ -1,27 +1,38 @@
-#pragma once
-#include "Game/UnitDefinition.hpp"
-#include "Engine/Math/IntVec2.hpp"
-
-
-class Unit
-{
-//public member functions
-public:
-	//constructor
-	Unit(UnitDefinition const* definition, IntVec2 startCoords, int ownerID);
-	
-	//game flow functions
-	void Render() const;
-
-//public member variables
-public:
-	UnitDefinition const* m_definition = nullptr;
-
-	IntVec2 m_coords = IntVec2();
-	
-	int m_currentHealth = 0;
-
-	int m_ownerID = 1;
-
-	bool m_movedThisTurn = false;
-};
+#pragma once
+#include "Game/UnitDefinition.hpp"
+#include "Engine/Math/IntVec2.hpp"
+
+
+//forward declarations
+struct ModelInstance;
+class Map;
+
+
+class Unit
+{
+//public member functions
+public:
+	//constructor
+	Unit(UnitDefinition const* definition, IntVec2 startCoords, int ownerID, int unitID);
+	
+	//rendering functions
+	ModelInstance GetModelInstance(Map const& map) const;
+
+//public member variables
+public:
+	UnitDefinition const* m_definition = nullptr;
+
+	IntVec2 m_coords = IntVec2();
+	
+	int m_currentHealth = 0;
+
+	int m_ownerID = 1;
+
+	//index the unit was created at in its owner's list, which stays the same as earlier units die
+	int m_unitID = 0;
+
+	bool m_movedThisTurn = false;
+
+	//level of detail the unit was last drawn at, or -1 if it was culled, so it only switches once it's clearly past a threshold
+	mutable int m_lodIndex = -1;
+};